@@ -0,0 +1,425 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include <algorithm>
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+namespace {
+
+/** Number of nodes allocated at once when the node pool runs dry. */
+const uint32_t NODES_PER_CHUNK = 256;
+
+/** Orders events so that the next one to run comes last. */
+struct EventGreater
+{
+  /**
+   * \param [in] a The first event.
+   * \param [in] b The second event.
+   * \returns \c true if \c a runs after \c b
+   */
+  bool operator () (const Scheduler::Event &a, const Scheduler::Event &b) const
+  {
+    return a.key > b.key;
+  }
+};
+
+} // unnamed namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_freeNodes (0),
+    m_topStart (0),
+    m_topMin (0),
+    m_topMax (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_top.head = 0;
+  m_top.size = 0;
+}
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Node *>::iterator i = m_chunks.begin (); i != m_chunks.end (); ++i)
+    {
+      delete [] *i;
+    }
+  m_chunks.clear ();
+  m_freeNodes = 0;
+}
+
+LadderScheduler::Node *
+LadderScheduler::AllocateNode (const Scheduler::Event &ev)
+{
+  if (m_freeNodes == 0)
+    {
+      Node *chunk = new Node [NODES_PER_CHUNK];
+      m_chunks.push_back (chunk);
+      for (uint32_t i = 0; i < NODES_PER_CHUNK; i++)
+        {
+          chunk[i].next = m_freeNodes;
+          m_freeNodes = &chunk[i];
+        }
+    }
+  Node *node = m_freeNodes;
+  m_freeNodes = node->next;
+  node->ev = ev;
+  node->next = 0;
+  return node;
+}
+void
+LadderScheduler::FreeNode (Node *node)
+{
+  node->next = m_freeNodes;
+  m_freeNodes = node;
+}
+void
+LadderScheduler::PushNode (Bucket &bucket, Node *node)
+{
+  node->next = bucket.head;
+  bucket.head = node;
+  bucket.size++;
+}
+void
+LadderScheduler::InsertIntoRung (Rung &rung, Node *node)
+{
+  uint64_t i = (node->ev.key.m_ts - rung.start) / rung.width;
+  NS_ASSERT (i >= rung.curBucket && i < rung.buckets.size ());
+  PushNode (rung.buckets[i], node);
+  rung.size++;
+}
+LadderScheduler::Rung &
+LadderScheduler::AddRung (uint64_t start, uint64_t width, uint64_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << start << width << nBuckets);
+  NS_ASSERT (m_nRungs < MAX_RUNGS);
+  Rung &rung = m_rungs[m_nRungs++];
+  Bucket empty;
+  empty.head = 0;
+  empty.size = 0;
+  rung.buckets.assign (nBuckets, empty);
+  rung.start = start;
+  rung.width = width;
+  rung.cur = start;
+  rung.curBucket = 0;
+  rung.size = 0;
+  return rung;
+}
+void
+LadderScheduler::InsertIntoBottom (const Scheduler::Event &ev)
+{
+  // m_bottom is sorted in decreasing order: find the first event
+  // which is smaller than the new one and insert before it.
+  std::vector<Scheduler::Event>::iterator i =
+    std::lower_bound (m_bottom.begin (), m_bottom.end (), ev,
+                      EventGreater ());
+  m_bottom.insert (i, ev);
+
+  if (m_bottom.size () > THRESHOLD && m_nRungs < MAX_RUNGS
+      && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      SpillBottom ();
+    }
+}
+void
+LadderScheduler::SpillBottom (void)
+{
+  NS_LOG_FUNCTION (this << m_bottom.size ());
+
+  // The new rung sits below every rung in use, and has to cover all
+  // the time stamps which would otherwise go to Bottom.
+  uint64_t start = m_bottom.back ().key.m_ts;
+  uint64_t end = m_nRungs > 0 ? m_rungs[m_nRungs - 1].cur : m_topStart;
+  NS_ASSERT (m_bottom.front ().key.m_ts < end);
+  uint64_t width = (end - start) / m_bottom.size () + 1;
+  uint64_t nBuckets = (end - start + width - 1) / width;
+  Rung &rung = AddRung (start, width, nBuckets);
+  for (std::vector<Scheduler::Event>::const_iterator i = m_bottom.begin (); i != m_bottom.end (); ++i)
+    {
+      InsertIntoRung (rung, AllocateNode (*i));
+    }
+  m_bottom.clear ();
+  Refill ();
+}
+
+void
+LadderScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size << m_topMin << m_topMax);
+  NS_ASSERT (m_nRungs == 0 && m_top.size > 0);
+
+  Node *node = m_top.head;
+  uint32_t size = m_top.size;
+  m_top.head = 0;
+  m_top.size = 0;
+
+  if (size <= THRESHOLD || m_topMin == m_topMax)
+    {
+      // Too few events to be worth a rung: sort them directly.
+      NS_ASSERT (m_bottom.empty ());
+      while (node != 0)
+        {
+          Node *next = node->next;
+          m_bottom.push_back (node->ev);
+          FreeNode (node);
+          node = next;
+        }
+      std::sort (m_bottom.begin (), m_bottom.end (), EventGreater ());
+      m_topStart = m_topMax + 1;
+      return;
+    }
+
+  uint64_t width = (m_topMax - m_topMin) / size + 1;
+  uint64_t nBuckets = (m_topMax - m_topMin) / width + 1;
+  Rung &rung = AddRung (m_topMin, width, nBuckets);
+  m_topStart = m_topMin + nBuckets * width;
+  while (node != 0)
+    {
+      Node *next = node->next;
+      InsertIntoRung (rung, node);
+      node = next;
+    }
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_bottom.empty ());
+
+  while (true)
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.size == 0)
+            {
+              // the scheduler is empty.
+              return;
+            }
+          TransferTop ();
+          if (!m_bottom.empty ())
+            {
+              return;
+            }
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.curBucket < rung.buckets.size ()
+             && rung.buckets[rung.curBucket].size == 0)
+        {
+          rung.curBucket++;
+        }
+      if (rung.curBucket == rung.buckets.size ())
+        {
+          // this rung is exhausted: go back to the one above it.
+          NS_ASSERT (rung.size == 0);
+          m_nRungs--;
+          continue;
+        }
+
+      Bucket bucket = rung.buckets[rung.curBucket];
+      uint64_t bucketStart = rung.start + rung.curBucket * rung.width;
+      rung.buckets[rung.curBucket].head = 0;
+      rung.buckets[rung.curBucket].size = 0;
+      rung.curBucket++;
+      rung.cur = bucketStart + rung.width;
+      rung.size -= bucket.size;
+
+      if (bucket.size > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          // spread the bucket over a finer rung.
+          uint64_t width = std::max<uint64_t> (1, rung.width / bucket.size);
+          uint64_t nBuckets = (rung.width + width - 1) / width;
+          Rung &child = AddRung (bucketStart, width, nBuckets);
+          for (Node *node = bucket.head; node != 0; )
+            {
+              Node *next = node->next;
+              InsertIntoRung (child, node);
+              node = next;
+            }
+          continue;
+        }
+
+      m_bottom.reserve (bucket.size);
+      for (Node *node = bucket.head; node != 0; )
+        {
+          Node *next = node->next;
+          m_bottom.push_back (node->ev);
+          FreeNode (node);
+          node = next;
+        }
+      std::sort (m_bottom.begin (), m_bottom.end (), EventGreater ());
+      return;
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+
+  if (ts >= m_topStart)
+    {
+      if (m_top.size == 0)
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      else
+        {
+          m_topMin = std::min (m_topMin, ts);
+          m_topMax = std::max (m_topMax, ts);
+        }
+      PushNode (m_top, AllocateNode (ev));
+    }
+  else
+    {
+      uint32_t i = 0;
+      while (i < m_nRungs && ts < m_rungs[i].cur)
+        {
+          i++;
+        }
+      if (i < m_nRungs)
+        {
+          InsertIntoRung (m_rungs[i], AllocateNode (ev));
+        }
+      else
+        {
+          InsertIntoBottom (ev);
+        }
+    }
+
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bottom.empty ();
+}
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom.back ();
+}
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+
+  Bucket *bucket = 0;
+  uint32_t *tierSize = 0;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      uint32_t i = 0;
+      while (i < m_nRungs && ts < m_rungs[i].cur)
+        {
+          i++;
+        }
+      if (i < m_nRungs)
+        {
+          Rung &rung = m_rungs[i];
+          bucket = &rung.buckets[(ts - rung.start) / rung.width];
+          tierSize = &rung.size;
+        }
+    }
+
+  if (bucket == 0)
+    {
+      std::vector<Scheduler::Event>::iterator i =
+        std::lower_bound (m_bottom.begin (), m_bottom.end (), ev,
+                          EventGreater ());
+      NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+      NS_ASSERT (i->impl == ev.impl);
+      m_bottom.erase (i);
+      if (m_bottom.empty ())
+        {
+          Refill ();
+        }
+      return;
+    }
+
+  for (Node **link = &bucket->head; *link != 0; link = &(*link)->next)
+    {
+      Node *node = *link;
+      if (node->ev.key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (node->ev.impl == ev.impl);
+          *link = node->next;
+          bucket->size--;
+          if (tierSize != 0)
+            {
+              (*tierSize)--;
+            }
+          FreeNode (node);
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+} // namespace ns3
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh
+ * and Ian Li-Jin Thng (2005).
+ *
+ * Events are kept in three tiers:
+ * - Top: an unsorted list of far future events;
+ * - Ladder: up to MAX_RUNGS rungs of buckets, each rung refining a
+ *   single bucket of the rung above it;
+ * - Bottom: a short sorted list of the earliest events.
+ *
+ * Only Bottom is ever sorted, and it is refilled one bucket at a time,
+ * so insertion and removal take O(1) amortized time regardless of the
+ * number of pending events.  Events in Top and in the Ladder live in
+ * pooled list nodes, which are recycled instead of being freed.
+ *
+ * Remove() has to search the bucket holding the event, which is linear
+ * in the bucket size.  EventId::Cancel() does not call it.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** A pooled list node holding one Event. */
+  struct Node
+  {
+    Scheduler::Event ev;   /**< The event. */
+    Node *next;            /**< Next node in the same list. */
+  };
+
+  /** An unsorted singly linked list of nodes. */
+  struct Bucket
+  {
+    Node *head;            /**< First node, or 0 if the bucket is empty. */
+    uint32_t size;         /**< Number of nodes in the bucket. */
+  };
+
+  /** A rung of the ladder: buckets of equal width covering a time range. */
+  struct Rung
+  {
+    std::vector<Bucket> buckets; /**< The buckets of this rung. */
+    uint64_t start;        /**< Time stamp at the start of bucket 0. */
+    uint64_t width;        /**< Width of each bucket. */
+    uint64_t cur;          /**< Events before this time stamp are in lower tiers. */
+    uint32_t curBucket;    /**< Index of the first bucket not yet dequeued. */
+    uint32_t size;         /**< Number of events in this rung. */
+  };
+
+  /** Refine a bucket into a new rung when it holds more events than this. */
+  static const uint32_t THRESHOLD = 50;
+  /** Maximum number of rungs in the ladder. */
+  static const uint32_t MAX_RUNGS = 8;
+
+  /**
+   * Take a node from the pool.
+   *
+   * \param [in] ev The event to store in the node.
+   * \returns The node.
+   */
+  Node * AllocateNode (const Scheduler::Event &ev);
+  /**
+   * Return a node to the pool.
+   *
+   * \param [in] node The node.
+   */
+  void FreeNode (Node *node);
+  /**
+   * Prepend a node to a bucket.
+   *
+   * \param [in,out] bucket The bucket.
+   * \param [in] node The node.
+   */
+  static void PushNode (Bucket &bucket, Node *node);
+  /**
+   * Put an event in the ladder rung \p rung.
+   *
+   * \param [in,out] rung The rung, which must cover the event time stamp.
+   * \param [in] node The node holding the event.
+   */
+  static void InsertIntoRung (Rung &rung, Node *node);
+  /**
+   * Set up rung number m_nRungs to cover [\p start, \p start + \p nBuckets * \p width).
+   *
+   * \param [in] start The start time stamp.
+   * \param [in] width The bucket width.
+   * \param [in] nBuckets The number of buckets.
+   * \returns The new rung.
+   */
+  Rung & AddRung (uint64_t start, uint64_t width, uint64_t nBuckets);
+  /**
+   * Insert an event into the sorted Bottom list, spilling it into a
+   * new rung if it grows too long.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertIntoBottom (const Scheduler::Event &ev);
+  /** Move the events of an overgrown Bottom into a new lowest rung. */
+  void SpillBottom (void);
+  /** Move the earliest events into Bottom, which must be empty. */
+  void Refill (void);
+  /** Move all Top events into a new first rung. */
+  void TransferTop (void);
+
+  /** Chunks of nodes allocated for the pool. */
+  std::vector<Node *> m_chunks;
+  /** Unused nodes. */
+  Node *m_freeNodes;
+
+  /** Far future events, unsorted. */
+  Bucket m_top;
+  /** Events at or after this time stamp go into Top. */
+  uint64_t m_topStart;
+  /** Smallest time stamp in Top. */
+  uint64_t m_topMin;
+  /** Largest time stamp in Top. */
+  uint64_t m_topMax;
+
+  /** The rungs, from coarsest to finest; only the first m_nRungs are in use. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+
+  /** The earliest events, sorted in decreasing order so the next event is at the back. */
+  std::vector<Scheduler::Event> m_bottom;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
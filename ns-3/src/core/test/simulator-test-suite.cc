@@ -23,6 +23,7 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 
 using namespace ns3;
 
@@ -461,6 +462,107 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorOrderTestCase : public TestCase
+{
+public:
+  SimulatorOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Schedule (void);
+  void Event (uint32_t order);
+  uint32_t Random (void);
+  uint32_t m_seed;
+  uint32_t m_scheduled;
+  uint32_t m_expected;
+  uint32_t m_ran;
+  uint32_t m_lastOrder;
+  Time m_last;
+  bool m_ok;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorOrderTestCase::SimulatorOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that many events run in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+uint32_t
+SimulatorOrderTestCase::Random (void)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return m_seed >> 8;
+}
+void
+SimulatorOrderTestCase::Schedule (void)
+{
+  // mostly near-future events, some far ones, and bursts at the same time
+  uint32_t r = Random ();
+  Time delay;
+  if (r % 5 == 0)
+    {
+      delay = NanoSeconds (Random () % 1000000000);
+    }
+  else if (r % 5 == 1)
+    {
+      delay = MicroSeconds (100);
+    }
+  else
+    {
+      delay = NanoSeconds (Random () % 1000);
+    }
+  EventId id = Simulator::Schedule (delay, &SimulatorOrderTestCase::Event, this, m_scheduled++);
+  if (Random () % 7 == 0)
+    {
+      Simulator::Remove (id);
+    }
+  else if (Random () % 7 == 0)
+    {
+      Simulator::Cancel (id);
+    }
+  else
+    {
+      m_expected++;
+    }
+}
+void
+SimulatorOrderTestCase::Event (uint32_t order)
+{
+  // events with the same time stamp run in the order they were scheduled
+  if (Now () < m_last || (Now () == m_last && order < m_lastOrder))
+    {
+      m_ok = false;
+    }
+  m_last = Now ();
+  m_lastOrder = order;
+  m_ran++;
+  if (m_scheduled < 20000)
+    {
+      Schedule ();
+    }
+}
+void
+SimulatorOrderTestCase::DoRun (void)
+{
+  m_seed = 1;
+  m_scheduled = 0;
+  m_expected = 0;
+  m_ran = 0;
+  m_lastOrder = 0;
+  m_last = Seconds (0);
+  m_ok = true;
+
+  Simulator::SetScheduler (m_schedulerFactory);
+  for (uint32_t i = 0; i < 5000; ++i)
+    {
+      Schedule ();
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_ok, true, "Events ran out of order");
+  NS_TEST_EXPECT_MSG_EQ (m_ran, m_expected, "Some events were lost or ran after being removed");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -477,5 +579,14 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
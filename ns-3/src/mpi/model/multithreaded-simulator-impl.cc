@@ -0,0 +1,892 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::g_current = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Mpi")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("MaxThreads",
+                   "The maximum number of threads, or 0 to use one per core.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_maxThreads),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+bool
+MultithreadedSimulatorImpl::IsEnabled (void)
+{
+  StringValue type;
+  GlobalValue::GetValueByName ("SimulatorImplementationType", type);
+  return type.Get () == "ns3::MultithreadedSimulatorImpl";
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_stop (false),
+    m_maxThreads (0),
+    m_lookAhead (GetMaximumSimulationTime ().GetTimeStep ()),
+    m_nChannels (0),
+    m_window (0),
+    m_running (0),
+    m_quit (false),
+    m_windowEnd (0),
+    m_windowEndUid (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_main = new Partition;
+  m_main->index = 0;
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  m_main->uid = 4;
+  // before ::Run is entered, the m_currentUid will be zero
+  m_main->currentUid = 0;
+  m_main->currentTs = 0;
+  m_main->currentContext = Simulator::NO_CONTEXT;
+  m_main->eventCount = 0;
+  m_main->unscheduledEvents = 0;
+  m_main->outboxTs[0] = GetMaximumSimulationTime ().GetTimeStep ();
+  m_main->outboxTs[1] = GetMaximumSimulationTime ().GetTimeStep ();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  StopWorkers ();
+  for (uint32_t i = 0; i <= m_partitions.size (); ++i)
+    {
+      Partition &partition = GetPartition (i);
+      while (!partition.events->IsEmpty ())
+        {
+          Scheduler::Event next = partition.events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (uint32_t parity = 0; parity < 2; ++parity)
+        {
+          for (uint32_t j = 0; j < partition.outbox[parity].size (); ++j)
+            {
+              std::vector<Scheduler::Event> &events = partition.outbox[parity][j];
+              for (std::vector<Scheduler::Event>::iterator k = events.begin (); k != events.end (); ++k)
+                {
+                  k->impl->Unref ();
+                }
+            }
+        }
+    }
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      delete m_partitions[i];
+    }
+  m_partitions.clear ();
+  m_nodePartition.clear ();
+  delete m_main;
+  m_main = 0;
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+
+  // Let the per-thread state of the models go while the simulator is
+  // still there to cancel their events.
+  StopWorkers ();
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+
+  m_schedulerFactory = schedulerFactory;
+  for (uint32_t i = 0; i <= m_partitions.size (); ++i)
+    {
+      Partition &partition = GetPartition (i);
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      if (partition.events != 0)
+        {
+          while (!partition.events->IsEmpty ())
+            {
+              Scheduler::Event next = partition.events->RemoveNext ();
+              scheduler->Insert (next);
+            }
+        }
+      partition.events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::PartitionNodes (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  bool isNew = false;
+  if (m_partitions.empty ())
+    {
+      CreatePartitions ();
+      if (m_partitions.empty ())
+        {
+          // no nodes yet: everything runs on the main thread.
+          return;
+        }
+      isNew = true;
+    }
+
+  uint32_t nPartitions = m_partitions.size ();
+  uint32_t nKnownNodes = m_nodePartition.size ();
+  if (nKnownNodes < NodeList::GetNNodes ())
+    {
+      m_nodePartition.resize (NodeList::GetNNodes ());
+      for (uint32_t i = nKnownNodes; i < m_nodePartition.size (); ++i)
+        {
+          m_nodePartition[i] = NodeList::GetNode (i)->GetSystemId () % nPartitions;
+        }
+      NS_LOG_INFO (m_nodePartition.size () << " nodes in " << nPartitions << " partitions");
+
+      // Hand the events scheduled so far for the new nodes to their
+      // partition.  They keep their uids, which no partition has used.
+      Ptr<Scheduler> events = m_schedulerFactory.Create<Scheduler> ();
+      while (!m_main->events->IsEmpty ())
+        {
+          Scheduler::Event next = m_main->events->RemoveNext ();
+          uint32_t index = GetPartitionIndex (next.key.m_context);
+          if (index == nPartitions)
+            {
+              events->Insert (next);
+              continue;
+            }
+          Partition &partition = *m_partitions[index];
+          partition.events->Insert (next);
+          partition.unscheduledEvents++;
+          m_main->unscheduledEvents--;
+        }
+      m_main->events = events;
+    }
+
+  if (isNew || m_nChannels != ChannelList::GetNChannels ())
+    {
+      CalculateLookAhead ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t nThreads = m_maxThreads;
+  if (nThreads == 0)
+    {
+      nThreads = std::max (1u, std::thread::hardware_concurrency ());
+    }
+  uint32_t nSystems = 0;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      nSystems = std::max (nSystems, (*i)->GetSystemId () + 1);
+    }
+  uint32_t nPartitions = std::min (nThreads, nSystems);
+
+  for (uint32_t i = 0; i < nPartitions; ++i)
+    {
+      Partition *partition = new Partition;
+      partition->index = i;
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+      partition->uid = m_main->uid;
+      partition->currentUid = 0;
+      partition->currentTs = m_main->currentTs;
+      partition->currentContext = Simulator::NO_CONTEXT;
+      partition->eventCount = 0;
+      partition->unscheduledEvents = 0;
+      for (uint32_t parity = 0; parity < 2; ++parity)
+        {
+          partition->outbox[parity].resize (nPartitions + 1);
+          partition->outboxTs[parity] = GetMaximumSimulationTime ().GetTimeStep ();
+        }
+      m_partitions.push_back (partition);
+    }
+
+  NS_ASSERT (m_window == 0);
+  m_quit = false;
+  for (uint32_t i = 1; i < nPartitions; ++i)
+    {
+      Ptr<SystemThread> thread =
+        Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::RunWorker, this).Bind (i));
+      thread->Start ();
+      m_threads.push_back (thread);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookAhead (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  TypeId remoteChannel;
+  bool haveRemoteChannel = TypeId::LookupByNameFailSafe ("ns3::PointToPointRemoteChannel",
+                                                         &remoteChannel);
+
+  m_nChannels = ChannelList::GetNChannels ();
+  m_lookAhead = GetMaximumSimulationTime ().GetTimeStep ();
+  for (ChannelList::Iterator i = ChannelList::Begin (); i != ChannelList::End (); ++i)
+    {
+      Ptr<Channel> channel = *i;
+      bool isRemote = false;
+      for (std::size_t j = 1; j < channel->GetNDevices (); ++j)
+        {
+          uint32_t first = m_nodePartition[channel->GetDevice (0)->GetNode ()->GetId ()];
+          uint32_t other = m_nodePartition[channel->GetDevice (j)->GetNode ()->GetId ()];
+          isRemote = isRemote || first != other;
+        }
+      if (!isRemote)
+        {
+          continue;
+        }
+
+      // Only the remote channel knows how to hand a packet over to
+      // another thread.
+      TypeId type = channel->GetInstanceTypeId ();
+      if (!haveRemoteChannel || (type != remoteChannel && !type.IsChildOf (remoteChannel)))
+        {
+          NS_FATAL_ERROR ("Channel " << channel->GetId () << " (" << type.GetName ()
+                          << ") connects nodes of different partitions;"
+                          " only point-to-point links can cross partitions");
+        }
+
+      TimeValue delay;
+      channel->GetAttribute ("Delay", delay);
+      if (!delay.Get ().IsStrictlyPositive ())
+        {
+          NS_FATAL_ERROR ("Channel " << channel->GetId ()
+                          << " connects nodes of different partitions with no delay");
+        }
+      m_lookAhead = std::min<uint64_t> (m_lookAhead, delay.Get ().GetTimeStep ());
+    }
+  NS_LOG_INFO ("lookahead " << TimeStep (m_lookAhead));
+}
+
+void
+MultithreadedSimulatorImpl::RunWorker (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+
+  g_current = m_partitions[index];
+  // The workers are started before the first window, and must not
+  // miss it if they are slow to start.
+  uint64_t window = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_windowMutex);
+        while (!m_quit && m_window == window)
+          {
+            m_windowStart.wait (lock);
+          }
+        if (m_quit)
+          {
+            return;
+          }
+        window = m_window;
+      }
+
+      ProcessWindow (index);
+
+      std::lock_guard<std::mutex> lock (m_windowMutex);
+      if (--m_running == 0)
+        {
+          m_windowDone.notify_one ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  {
+    std::lock_guard<std::mutex> lock (m_windowMutex);
+    m_quit = true;
+  }
+  m_windowStart.notify_all ();
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_threads.begin (); i != m_threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_threads.clear ();
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow (void)
+{
+  NS_LOG_FUNCTION (this << m_windowEnd << m_windowEndUid);
+
+  SynchronizeUids ();
+  {
+    std::lock_guard<std::mutex> lock (m_windowMutex);
+    m_running = m_threads.size ();
+    m_window++;
+  }
+  m_windowStart.notify_all ();
+
+  g_current = m_partitions[0];
+  ProcessWindow (0);
+  g_current = 0;
+
+  {
+    std::unique_lock<std::mutex> lock (m_windowMutex);
+    while (m_running != 0)
+      {
+        m_windowDone.wait (lock);
+      }
+  }
+
+  // Events for the main thread can run before the next window, while
+  // the events for the partitions wait for it.
+  uint32_t parity = m_window & 1;
+  DrainOutboxes (m_partitions.size (), parity);
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      // this parity was drained at the start of the window.
+      m_partitions[i]->outboxTs[1 - parity] = GetMaximumSimulationTime ().GetTimeStep ();
+    }
+  SynchronizeUids ();
+}
+
+void
+MultithreadedSimulatorImpl::SynchronizeUids (void)
+{
+  uint32_t uid = m_main->uid;
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      uid = std::max (uid, m_partitions[i]->uid);
+    }
+  m_main->uid = uid;
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      m_partitions[i]->uid = uid;
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsInWindow (const Scheduler::EventKey &key) const
+{
+  return key.m_ts < m_windowEnd
+         || (key.m_ts == m_windowEnd && key.m_uid < m_windowEndUid);
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (uint32_t index)
+{
+  Partition &partition = *m_partitions[index];
+  DrainOutboxes (index, 1 - (m_window & 1));
+  // A Stop() from a node is only seen by Run() once the window is over,
+  // so that every partition runs the whole window whatever the timing of
+  // the threads.
+  while (!partition.events->IsEmpty ()
+         && IsInWindow (partition.events->PeekNext ().key))
+    {
+      ProcessOneEvent (partition);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DrainOutboxes (uint32_t index, uint32_t parity)
+{
+  // Always visit the sources in the same order, so that simultaneous
+  // events get the same uids from one run to the next.
+  Partition &partition = GetPartition (index);
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      std::vector<Scheduler::Event> &events = m_partitions[i]->outbox[parity][index];
+      for (std::vector<Scheduler::Event>::iterator j = events.begin (); j != events.end (); ++j)
+        {
+          Insert (partition, *j);
+        }
+      events.clear ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition &partition)
+{
+  Scheduler::Event next = partition.events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition.currentTs);
+  partition.unscheduledEvents--;
+  partition.eventCount++;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  partition.currentTs = next.key.m_ts;
+  partition.currentContext = next.key.m_context;
+  partition.currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Insert (Partition &partition, Scheduler::Event &ev)
+{
+  ev.key.m_uid = partition.uid;
+  partition.uid++;
+  partition.unscheduledEvents++;
+  partition.events->Insert (ev);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionIndex (uint32_t context) const
+{
+  if (context < m_nodePartition.size ())
+    {
+      return m_nodePartition[context];
+    }
+  return m_partitions.size ();
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetPartition (uint32_t index) const
+{
+  if (index < m_partitions.size ())
+    {
+      return *m_partitions[index];
+    }
+  return *m_main;
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetCurrent (void) const
+{
+  return g_current != 0 ? *g_current : *m_main;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs (const Partition &partition) const
+{
+  if (partition.events->IsEmpty ())
+    {
+      return GetMaximumSimulationTime ().GetTimeStep ();
+    }
+  return partition.events->PeekNext ().key.m_ts;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  const uint64_t maxTs = GetMaximumSimulationTime ().GetTimeStep ();
+  for (uint32_t i = 0; i <= m_partitions.size (); ++i)
+    {
+      const Partition &partition = GetPartition (i);
+      if (!partition.events->IsEmpty ()
+          || partition.outboxTs[0] != maxTs
+          || partition.outboxTs[1] != maxTs)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  PartitionNodes ();
+
+  const uint64_t maxTs = GetMaximumSimulationTime ().GetTimeStep ();
+  m_stop = false;
+  while (!m_stop)
+    {
+      uint64_t mainTs = NextTs (*m_main);
+      uint64_t nodeTs = maxTs;
+      for (uint32_t i = 0; i < m_partitions.size (); ++i)
+        {
+          Partition &partition = *m_partitions[i];
+          nodeTs = std::min (nodeTs, NextTs (partition));
+          nodeTs = std::min (nodeTs, partition.outboxTs[0]);
+          nodeTs = std::min (nodeTs, partition.outboxTs[1]);
+        }
+      if (mainTs == maxTs && nodeTs == maxTs)
+        {
+          break;
+        }
+
+      // Simultaneous events run in the order they were scheduled, as
+      // with DefaultSimulatorImpl: the uids tell which of the partition
+      // events at mainTs come before the next main event.
+      m_windowEndUid = 0;
+      if (mainTs != maxTs)
+        {
+          m_windowEndUid = m_main->events->PeekNext ().key.m_uid;
+        }
+      bool mainFirst = mainTs < nodeTs;
+      if (mainTs == nodeTs)
+        {
+          m_windowEnd = mainTs;
+          mainFirst = true;
+          for (uint32_t i = 0; i < m_partitions.size () && mainFirst; ++i)
+            {
+              Partition &partition = *m_partitions[i];
+              mainFirst = partition.events->IsEmpty ()
+                || !IsInWindow (partition.events->PeekNext ().key);
+            }
+        }
+      if (mainFirst)
+        {
+          ProcessOneEvent (*m_main);
+          continue;
+        }
+
+      // Nothing a partition does before nodeTs + lookahead can reach
+      // another one before then.
+      m_windowEnd = nodeTs + std::min (m_lookAhead, maxTs - nodeTs);
+      if (m_windowEnd >= mainTs)
+        {
+          m_windowEnd = mainTs;
+        }
+      else
+        {
+          m_windowEndUid = 0;
+        }
+      RunWindow ();
+    }
+
+  // Leave nothing in the outboxes, in case Run is called again, and
+  // bring the clock of the main program up to date.
+  uint64_t lastTs = m_main->currentTs;
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      DrainOutboxes (i, 0);
+      DrainOutboxes (i, 1);
+      m_partitions[i]->outboxTs[0] = maxTs;
+      m_partitions[i]->outboxTs[1] = maxTs;
+      lastTs = std::max (lastTs, m_partitions[i]->currentTs);
+    }
+  m_main->currentTs = std::min (lastTs, NextTs (*m_main));
+  SynchronizeUids ();
+  m_main->currentContext = Simulator::NO_CONTEXT;
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  for (uint32_t i = 0; i <= m_partitions.size (); ++i)
+    {
+      NS_ASSERT (!GetPartition (i).events->IsEmpty () || GetPartition (i).unscheduledEvents == 0);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return GetCurrent ().index;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (const Time &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+
+  Simulator::Schedule (delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (const Time &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+
+  Partition &partition = GetCurrent ();
+  Time tAbsolute = delay + TimeStep (partition.currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (partition.currentTs));
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = static_cast<uint64_t> (tAbsolute.GetTimeStep ());
+  ev.key.m_context = partition.currentContext;
+  Insert (partition, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+
+  Partition &source = GetCurrent ();
+  uint32_t index = GetPartitionIndex (context);
+  Partition &destination = GetPartition (index);
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = source.currentTs + delay.GetTimeStep ();
+  ev.key.m_context = context;
+
+  if (&source == &destination)
+    {
+      Insert (destination, ev);
+      return;
+    }
+
+  // The main program only runs while the partitions wait.  Its events
+  // for a partition take their uid from its own counter, so that they
+  // stay in order with the events it schedules for itself, such as a
+  // Stop right after.
+  if (&source == m_main)
+    {
+      destination.uid = std::max (destination.uid, m_main->uid);
+      Insert (destination, ev);
+      m_main->uid = destination.uid;
+      return;
+    }
+
+  if (ev.key.m_ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event for context " << context << " scheduled " << delay
+                      << " ahead from context " << source.currentContext
+                      << ", which is less than the lookahead between their partitions");
+    }
+  uint32_t parity = m_window & 1;
+  source.outbox[parity][index].push_back (ev);
+  if (&destination != m_main)
+    {
+      source.outboxTs[parity] = std::min (source.outboxTs[parity], ev.key.m_ts);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+
+  Partition &partition = GetCurrent ();
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = partition.currentTs;
+  ev.key.m_context = partition.currentContext;
+  Insert (partition, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+
+  EventId id (Ptr<EventImpl> (event, false), GetCurrent ().currentTs, 0xffffffff, 2);
+  std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  return TimeStep (GetCurrent ().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetPartition (GetPartitionIndex (id.GetContext ())).currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition &partition = GetPartition (GetPartitionIndex (id.GetContext ()));
+  if (&partition != &GetCurrent ())
+    {
+      // The queue belongs to another thread: leave the event there, it
+      // is skipped when it expires.
+      id.PeekEventImpl ()->Cancel ();
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition.events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  const Partition &partition = GetPartition (GetPartitionIndex (id.GetContext ()));
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < partition.currentTs
+      || (id.GetTs () == partition.currentTs
+          && id.GetUid () <= partition.currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return GetCurrent ().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = 0;
+  for (uint32_t i = 0; i <= m_partitions.size (); ++i)
+    {
+      count += GetPartition (i).eventCount;
+    }
+  return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-thread.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \ingroup mpi
+ *
+ * \brief Conservative parallel simulator implementation running the
+ * partitions of a single process on several threads.
+ *
+ * The nodes are split into partitions by system id, exactly as they
+ * would be split across MPI ranks by DistributedSimulatorImpl: node
+ * \c n belongs to partition <tt>n->GetSystemId () % N</tt>, where
+ * \c N is the number of threads.  Each partition has its own event
+ * queue, and runs the events of its nodes (those scheduled with
+ * Simulator::ScheduleWithContext() for the node id) on its own thread.
+ *
+ * The partitions advance in lock step, one time window at a time.  A
+ * window starts at the earliest pending event \c T and ends at
+ * <tt>T + lookahead</tt>, where the lookahead is the smallest delay of
+ * the point-to-point channels connecting two partitions.  An event sent
+ * to another partition can therefore never land inside the current
+ * window, and is kept in a per-thread outbox until the destination
+ * picks it up at the start of the next window: no lock is taken on the
+ * event path, and events from other partitions are always merged in the
+ * same order, which keeps runs reproducible.
+ *
+ * Events without a context (the ones scheduled from the main program,
+ * such as Simulator::Stop or periodic tracers) are run on the main
+ * thread while all the partitions wait.  Simultaneous events of the
+ * main program and of the nodes run in the order they were scheduled,
+ * as with DefaultSimulatorImpl: an event scheduled for a node at time
+ * 0, followed by Simulator::Stop (Seconds (0)), runs before the stop,
+ * as ns3::ndn::StackHelper expects.  This order is not kept for the
+ * events sent from one partition to another.
+ *
+ * The number of partitions is set by the first Simulator::Run() from
+ * the system ids of the nodes which exist at that point.  The nodes and
+ * channels created between two runs are taken into account by the next
+ * one; they must not be created while the simulation is running.
+ *
+ * To use it, set the "SimulatorImplementationType" global value to
+ * "ns3::MultithreadedSimulatorImpl" before any other call to the
+ * simulator, and give the nodes different system ids.
+ * PointToPointHelper then connects nodes with different system ids
+ * through a PointToPointRemoteChannel, which hands packets to the
+ * other thread.  Other channels must not cross partitions.
+ *
+ * Limitations:
+ * - an EventId can only be removed, and its expiration checked, from
+ *   the partition which scheduled it, or from the main program;
+ * - Simulator::Stop() called from a node only takes effect at the end
+ *   of the current time window;
+ * - all the code run from node events (models, applications, trace
+ *   sinks) must only touch the state of its own node: shared output
+ *   streams or global counters need their own locking;
+ * - packet metadata (PacketMetadata::Enable()) is not supported.
+ *
+ * GetSystemId() returns the index of the partition of the calling
+ * thread, and packets take their uids from a per-thread counter, so the
+ * packet uids of a run do not depend on the scheduling of the threads.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \returns \c true if the "SimulatorImplementationType" global value
+   * selects this implementation.
+   */
+  static bool IsEnabled (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** The event queue and the clock of one partition. */
+  struct Partition
+  {
+    /**
+     * Index of the partition, also its system id.  The main partition
+     * shares system id 0 with partition 0, which runs on the same thread.
+     */
+    uint32_t index;
+    /** The event priority queue. */
+    Ptr<Scheduler> events;
+    /**
+     * Next event unique id.  All the partitions restart from the
+     * largest one at every switch between the main program and the
+     * windows, so that the uids of the main program and of a partition
+     * follow the order in which their events were scheduled.
+     */
+    uint32_t uid;
+    /** Unique id of the current event. */
+    uint32_t currentUid;
+    /** Timestamp of the current event. */
+    uint64_t currentTs;
+    /** Execution context of the current event. */
+    uint32_t currentContext;
+    /** The event count. */
+    uint64_t eventCount;
+    /**
+     * Number of events that have been inserted but not yet scheduled;
+     * this is used for validation.
+     */
+    int unscheduledEvents;
+    /**
+     * Events sent to the other partitions, indexed by window parity,
+     * then by destination partition.  The partition which owns them
+     * appends during even (odd) windows, and the destination drains
+     * them at the start of the next odd (even) window.
+     */
+    std::vector<std::vector<Scheduler::Event> > outbox[2];
+    /**
+     * Earliest time stamp in outbox[i], not counting the events for
+     * the main thread, which are drained at the end of every window.
+     */
+    uint64_t outboxTs[2];
+  };
+
+  /**
+   * Assign the nodes created since the last Run to the partitions, move
+   * their events out of the main queue, and update the lookahead if
+   * the partitions were just created or channels were added.  Called by
+   * every Run.
+   */
+  void PartitionNodes (void);
+  /** Create the partitions and start the worker threads. */
+  void CreatePartitions (void);
+  /** Compute m_lookAhead from the channels connecting two partitions. */
+  void CalculateLookAhead (void);
+  /** Restart the uids of all the partitions from the largest one. */
+  void SynchronizeUids (void);
+  /**
+   * \param [in] key The key of an event.
+   * \returns \c true if the event runs in the current window.
+   */
+  bool IsInWindow (const Scheduler::EventKey &key) const;
+  /**
+   * Worker thread body: run the windows of one partition until
+   * m_quit is set.
+   *
+   * \param [in] index The partition index.
+   */
+  void RunWorker (uint32_t index);
+  /** Stop and join the worker threads. */
+  void StopWorkers (void);
+  /**
+   * Run all the partitions up to m_windowEnd: start the window on the
+   * worker threads, run partition 0 on this one, and wait for the others.
+   */
+  void RunWindow (void);
+  /**
+   * Run the events of one partition up to m_windowEnd, after pulling
+   * the events sent to it during the previous window.
+   *
+   * \param [in] index The partition index.
+   */
+  void ProcessWindow (uint32_t index);
+  /**
+   * Move the events in the outboxes of all the partitions for
+   * destination \p index and window parity \p parity into its queue.
+   *
+   * \param [in] index The destination partition.
+   * \param [in] parity The window parity.
+   */
+  void DrainOutboxes (uint32_t index, uint32_t parity);
+  /**
+   * Process the next event of a partition.
+   *
+   * \param [in,out] partition The partition.
+   */
+  void ProcessOneEvent (Partition &partition);
+  /**
+   * Insert an event in the queue of a partition, giving it the next
+   * unique id of that partition.
+   *
+   * \param [in,out] partition The partition.
+   * \param [in,out] ev The event.
+   */
+  static void Insert (Partition &partition, Scheduler::Event &ev);
+  /**
+   * \param [in] context An event context.
+   * \returns The index of the partition running the events of \p context.
+   */
+  uint32_t GetPartitionIndex (uint32_t context) const;
+  /**
+   * \param [in] index A partition index.
+   * \returns The partition, or the main thread one.
+   */
+  Partition & GetPartition (uint32_t index) const;
+  /** \returns The partition of the calling thread. */
+  Partition & GetCurrent (void) const;
+  /**
+   * \param [in] partition A partition.
+   * \returns The time stamp of its next event, or the maximum time
+   * stamp if it has none.
+   */
+  uint64_t NextTs (const Partition &partition) const;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Mutex to control access to the list of events to run at Destroy. */
+  mutable std::mutex m_destroyEventsMutex;
+
+  /** Flag calling for the end of the simulation. */
+  std::atomic<bool> m_stop;
+  /** Factory for the event queues. */
+  ObjectFactory m_schedulerFactory;
+  /** Maximum number of threads, or 0 to use one per core. */
+  uint32_t m_maxThreads;
+
+  /** The partition of the main thread, for events without a node context. */
+  Partition *m_main;
+  /** The node partitions, one per thread. */
+  std::vector<Partition *> m_partitions;
+  /** The partition index of each node, by node id. */
+  std::vector<uint32_t> m_nodePartition;
+  /**
+   * Lookahead: the smallest delay between two partitions, or the
+   * maximum time stamp if no channel crosses partitions.
+   */
+  uint64_t m_lookAhead;
+  /** Number of channels when m_lookAhead was computed. */
+  uint32_t m_nChannels;
+
+  /** The worker threads, running partitions 1 to N-1. */
+  std::vector<Ptr<SystemThread> > m_threads;
+  /** Mutex protecting the window hand-off below. */
+  std::mutex m_windowMutex;
+  /** Signaled when a new window starts, or the workers have to quit. */
+  std::condition_variable m_windowStart;
+  /** Signaled when the last worker is done with the current window. */
+  std::condition_variable m_windowDone;
+  /** Number of the current window. */
+  uint64_t m_window;
+  /** Number of workers still running the current window. */
+  uint32_t m_running;
+  /** Flag asking the worker threads to exit. */
+  bool m_quit;
+  /** Events must be earlier than this time stamp to run in the current window. */
+  uint64_t m_windowEnd;
+  /** The events at m_windowEnd with a smaller uid also run in the current window. */
+  uint32_t m_windowEndUid;
+
+  /** The partition the calling thread is running, or 0 for the main partition. */
+  static thread_local Partition *g_current;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
@@ -63,6 +63,7 @@
 #include <ndn-cxx/delegation-list.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/name.hpp>
+#include <ndn-cxx/prefix-view.hpp>
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/lp/nack.hpp>
 #include <ndn-cxx/net/face-uri.hpp>
@@ -110,6 +111,7 @@ using ndn::FaceUri;
 using ndn::Interest;
 using ndn::Name;
 using ndn::PartialName;
+using ndn::PrefixView;
 using ndn::Scheduler;
 
 // Not using a namespace alias (namespace tlv = ndn::tlv), because
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "slab-allocator.hpp"
+
+namespace nfd {
+
+Slab::Slab(size_t nChunksPerBlock)
+  : m_nChunksPerBlock(nChunksPerBlock)
+{
+  BOOST_ASSERT(nChunksPerBlock > 0);
+}
+
+Slab::~Slab()
+{
+  BOOST_ASSERT(m_nChunksInUse == 0);
+  for (void* block : m_blocks) {
+    ::operator delete(block);
+  }
+}
+
+size_t
+Slab::roundUp(size_t size)
+{
+  constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+  size = std::max(size, sizeof(FreeChunk));
+  return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+void*
+Slab::allocate(size_t size)
+{
+  size = roundUp(size);
+  if (m_chunkSize == 0) {
+    m_chunkSize = size;
+  }
+  else if (size != m_chunkSize) {
+    return ::operator new(size);
+  }
+
+  if (m_freeList == nullptr) {
+    this->grow();
+  }
+  FreeChunk* chunk = m_freeList;
+  m_freeList = chunk->next;
+  ++m_nChunksInUse;
+  return chunk;
+}
+
+void
+Slab::deallocate(void* p, size_t size) noexcept
+{
+  if (roundUp(size) != m_chunkSize) {
+    ::operator delete(p);
+    return;
+  }
+
+  auto chunk = static_cast<FreeChunk*>(p);
+  chunk->next = m_freeList;
+  m_freeList = chunk;
+  --m_nChunksInUse;
+}
+
+void
+Slab::grow()
+{
+  auto block = static_cast<uint8_t*>(::operator new(m_chunkSize * m_nChunksPerBlock));
+  m_blocks.push_back(block);
+
+  // thread the new chunks onto the free list, lowest address first
+  for (size_t i = m_nChunksPerBlock; i > 0; --i) {
+    auto chunk = reinterpret_cast<FreeChunk*>(block + (i - 1) * m_chunkSize);
+    chunk->next = m_freeList;
+    m_freeList = chunk;
+  }
+}
+
+} // namespace nfd
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SLAB_ALLOCATOR_HPP
+#define NFD_DAEMON_COMMON_SLAB_ALLOCATOR_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+
+/** \brief a pool of equally sized memory chunks
+ *
+ *  The chunk size is fixed by the first allocation. Chunks are carved out of blocks of
+ *  \p nChunksPerBlock chunks and recycled through a free list, so a steady state of
+ *  allocations and deallocations does not reach the system allocator. Blocks are released
+ *  only when the Slab is destroyed.
+ *
+ *  Requests of another size are passed through to the system allocator.
+ */
+class Slab : noncopyable
+{
+public:
+  explicit
+  Slab(size_t nChunksPerBlock = 256);
+
+  ~Slab();
+
+  void*
+  allocate(size_t size);
+
+  /** \pre \p p was returned by allocate(size) on this Slab
+   */
+  void
+  deallocate(void* p, size_t size) noexcept;
+
+  /** \return size of a chunk, or 0 before the first allocation
+   */
+  size_t
+  getChunkSize() const
+  {
+    return m_chunkSize;
+  }
+
+  /** \return number of chunks in use
+   */
+  size_t
+  size() const
+  {
+    return m_nChunksInUse;
+  }
+
+  /** \return number of chunks carved out of the system allocator so far
+   */
+  size_t
+  capacity() const
+  {
+    return m_blocks.size() * m_nChunksPerBlock;
+  }
+
+private:
+  static size_t
+  roundUp(size_t size);
+
+  void
+  grow();
+
+private:
+  struct FreeChunk
+  {
+    FreeChunk* next;
+  };
+
+  size_t m_nChunksPerBlock;
+  size_t m_chunkSize = 0;
+  size_t m_nChunksInUse = 0;
+  FreeChunk* m_freeList = nullptr;
+  std::vector<void*> m_blocks;
+};
+
+/** \brief an allocator drawing single objects from a shared Slab
+ *
+ *  Copies, including rebound copies, share the Slab and keep it alive, so objects may
+ *  outlive the owner of the allocator they were created with. This makes it suitable for
+ *  \c std::allocate_shared, which rebinds the allocator to the type of its control block.
+ */
+template<typename T>
+class SlabAllocator
+{
+public:
+  using value_type = T;
+
+  explicit
+  SlabAllocator(shared_ptr<Slab> slab)
+    : m_slab(std::move(slab))
+  {
+  }
+
+  template<typename U>
+  SlabAllocator(const SlabAllocator<U>& other) noexcept
+    : m_slab(other.getSlab())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(m_slab->allocate(sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    m_slab->deallocate(p, sizeof(T));
+  }
+
+  const shared_ptr<Slab>&
+  getSlab() const noexcept
+  {
+    return m_slab;
+  }
+
+  template<typename U>
+  friend bool
+  operator==(const SlabAllocator& lhs, const SlabAllocator<U>& rhs) noexcept
+  {
+    return lhs.m_slab == rhs.getSlab();
+  }
+
+  template<typename U>
+  friend bool
+  operator!=(const SlabAllocator& lhs, const SlabAllocator<U>& rhs) noexcept
+  {
+    return lhs.m_slab != rhs.getSlab();
+  }
+
+private:
+  shared_ptr<Slab> m_slab;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SLAB_ALLOCATOR_HPP
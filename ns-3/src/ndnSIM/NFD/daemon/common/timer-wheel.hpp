@@ -0,0 +1,340 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+#define NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+
+#include "common/global.hpp"
+
+#include <array>
+#include <bitset>
+
+namespace nfd {
+
+/** \brief a hierarchical timing wheel driving many timers with one scheduler event
+ *  \tparam T type of the objects that embed a Timer
+ *
+ *  Time is divided into ticks of a fixed resolution, counted from the construction of the wheel.
+ *  A timer is filed into one of four levels of 256 slots, depending on how far its expiry tick
+ *  is from the current tick, and is moved to a lower level when the wheel reaches its block.
+ *  Scheduling and cancelling a timer are constant-time list operations that allocate nothing.
+ *
+ *  The wheel keeps a single event on the global scheduler, set to the next tick that has timers
+ *  to expire or to move; no event is scheduled while the wheel is empty. A timer with a positive
+ *  delay expires at the first tick not earlier than its deadline, that is, at most one resolution
+ *  late. A timer with zero delay expires at the current time, in an event shared with all other
+ *  timers due at that time.
+ */
+template<typename T>
+class TimerWheel : noncopyable
+{
+public:
+  /** \brief a timer embedded in an object of type T
+   *
+   *  A Timer is cancelled when it is destructed.
+   */
+  class Timer : noncopyable
+  {
+  public:
+    explicit
+    Timer(T& owner) noexcept
+      : m_owner(owner)
+    {
+    }
+
+    ~Timer()
+    {
+      cancel();
+    }
+
+    bool
+    isScheduled() const noexcept
+    {
+      return m_wheel != nullptr;
+    }
+
+    void
+    cancel() noexcept
+    {
+      if (m_wheel != nullptr) {
+        m_wheel->remove(*this);
+      }
+    }
+
+  private:
+    T& m_owner;
+    TimerWheel* m_wheel = nullptr;
+    Timer* m_prev = nullptr;
+    Timer* m_next = nullptr;
+    uint64_t m_tick = 0;
+    size_t m_slot = 0;
+
+    friend TimerWheel;
+  };
+
+  /** \brief invoked with the owner of an expired timer
+   *
+   *  The timer is no longer scheduled when the callback is invoked, and may be scheduled again.
+   */
+  using ExpireCallback = std::function<void(T& owner)>;
+
+  explicit
+  TimerWheel(ExpireCallback expire, time::nanoseconds resolution = 1_ms)
+    : m_expire(std::move(expire))
+    , m_resolution(resolution)
+    , m_origin(time::steady_clock::now())
+  {
+    BOOST_ASSERT(m_resolution > time::nanoseconds::zero());
+  }
+
+  ~TimerWheel()
+  {
+    for (Timer*& head : m_slots) {
+      for (Timer* timer = head; timer != nullptr; timer = timer->m_next) {
+        timer->m_wheel = nullptr;
+      }
+      head = nullptr;
+    }
+  }
+
+  /** \brief (re)schedule \p timer to expire after \p delay
+   */
+  void
+  schedule(Timer& timer, time::nanoseconds delay)
+  {
+    timer.cancel();
+    auto now = time::steady_clock::now();
+
+    if (delay <= time::nanoseconds::zero()) {
+      timer.m_tick = m_currentTick;
+      link(timer, DUE_SLOT);
+      scheduleTick(now);
+      return;
+    }
+
+    if (m_size == 0) {
+      // nothing is filed relative to the current tick, so the wheel can catch up at once
+      m_currentTick = toTick(now);
+    }
+    auto deadline = now + delay - m_origin;
+    timer.m_tick = static_cast<uint64_t>((deadline.count() + m_resolution.count() - 1) /
+                                         m_resolution.count());
+    insert(timer);
+    scheduleTick(toTimePoint(timer.m_tick));
+  }
+
+  /** \return number of scheduled timers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  time::nanoseconds
+  getResolution() const
+  {
+    return m_resolution;
+  }
+
+private:
+  uint64_t
+  toTick(time::steady_clock::TimePoint t) const
+  {
+    return static_cast<uint64_t>((t - m_origin) / m_resolution);
+  }
+
+  time::steady_clock::TimePoint
+  toTimePoint(uint64_t tick) const
+  {
+    return m_origin + m_resolution * static_cast<time::nanoseconds::rep>(tick);
+  }
+
+  void
+  link(Timer& timer, size_t slot)
+  {
+    timer.m_wheel = this;
+    timer.m_slot = slot;
+    timer.m_prev = nullptr;
+    timer.m_next = m_slots[slot];
+    if (timer.m_next != nullptr) {
+      timer.m_next->m_prev = &timer;
+    }
+    m_slots[slot] = &timer;
+    if (slot < N_SLOTS_PER_LEVEL) {
+      m_isLevel0Occupied.set(slot);
+    }
+    ++m_size;
+  }
+
+  void
+  remove(Timer& timer) noexcept
+  {
+    (timer.m_prev == nullptr ? m_slots[timer.m_slot] : timer.m_prev->m_next) = timer.m_next;
+    if (timer.m_next != nullptr) {
+      timer.m_next->m_prev = timer.m_prev;
+    }
+    if (timer.m_slot < N_SLOTS_PER_LEVEL && m_slots[timer.m_slot] == nullptr) {
+      m_isLevel0Occupied.reset(timer.m_slot);
+    }
+    timer.m_wheel = nullptr;
+    --m_size;
+  }
+
+  /** \brief file \p timer into the slot for its expiry tick relative to the current tick
+   *
+   *  A timer goes to the lowest level whose block contains both ticks. Timers beyond the range
+   *  of the top level go to the top-level slot visited last, and are filed again from there.
+   */
+  void
+  insert(Timer& timer)
+  {
+    uint64_t tick = std::max(timer.m_tick, m_currentTick);
+    for (size_t level = 0; level < N_LEVELS; ++level) {
+      size_t blockShift = SLOT_BITS * (level + 1);
+      if ((tick >> blockShift) == (m_currentTick >> blockShift)) {
+        link(timer, level * N_SLOTS_PER_LEVEL + ((tick >> (SLOT_BITS * level)) & SLOT_MASK));
+        return;
+      }
+    }
+    size_t topShift = SLOT_BITS * (N_LEVELS - 1);
+    link(timer, (N_LEVELS - 1) * N_SLOTS_PER_LEVEL +
+                (((m_currentTick >> topShift) + SLOT_MASK) & SLOT_MASK));
+  }
+
+  /** \brief move timers of the blocks starting at the current tick to lower levels
+   *  \pre the current tick is the first of a level-0 block
+   */
+  void
+  cascade()
+  {
+    size_t level = 1;
+    while (level < N_LEVELS - 1 && ((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK) == 0) {
+      ++level;
+    }
+    for (; level > 0; --level) {
+      size_t slot = level * N_SLOTS_PER_LEVEL + ((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+      while (m_slots[slot] != nullptr) {
+        Timer& timer = *m_slots[slot];
+        remove(timer);
+        insert(timer);
+      }
+    }
+  }
+
+  void
+  expireSlot(size_t slot)
+  {
+    while (m_slots[slot] != nullptr) {
+      Timer& timer = *m_slots[slot];
+      remove(timer);
+      m_expire(timer.m_owner);
+    }
+  }
+
+  /** \return the next tick at which a level-0 slot expires or a block boundary is reached
+   */
+  uint64_t
+  findNextTick() const
+  {
+    for (size_t i = (m_currentTick & SLOT_MASK) + 1; i < N_SLOTS_PER_LEVEL; ++i) {
+      if (m_isLevel0Occupied.test(i)) {
+        return (m_currentTick & ~static_cast<uint64_t>(SLOT_MASK)) | i;
+      }
+    }
+    return ((m_currentTick >> SLOT_BITS) + 1) << SLOT_BITS;
+  }
+
+  void
+  scheduleTick(time::steady_clock::TimePoint t)
+  {
+    if (m_isAdvancing || t >= m_nextTickTime) {
+      return;
+    }
+    m_nextTickTime = t;
+    m_tickEvent = getScheduler().schedule(std::max(t - time::steady_clock::now(),
+                                                   time::steady_clock::Duration::zero()),
+                                          [this] { advance(); });
+  }
+
+  void
+  advance()
+  {
+    m_nextTickTime = time::steady_clock::TimePoint::max();
+    m_isAdvancing = true;
+
+    auto now = time::steady_clock::now();
+    uint64_t target = toTick(now);
+    expireSlot(DUE_SLOT);
+    while (m_currentTick < target && m_size > 0) {
+      uint64_t next = findNextTick();
+      if (next > target) {
+        break;
+      }
+      m_currentTick = next;
+      if ((m_currentTick & SLOT_MASK) == 0) {
+        cascade();
+      }
+      expireSlot(m_currentTick & SLOT_MASK);
+    }
+    if (m_size == 0 || findNextTick() > target) {
+      // no slot is left between the current tick and target
+      m_currentTick = std::max(m_currentTick, target);
+    }
+    expireSlot(DUE_SLOT);
+
+    m_isAdvancing = false;
+    if (m_slots[DUE_SLOT] != nullptr) {
+      scheduleTick(now);
+    }
+    else if (m_size > 0) {
+      scheduleTick(toTimePoint(findNextTick()));
+    }
+  }
+
+private:
+  static constexpr size_t SLOT_BITS = 8;
+  static constexpr size_t N_SLOTS_PER_LEVEL = 1 << SLOT_BITS;
+  static constexpr size_t SLOT_MASK = N_SLOTS_PER_LEVEL - 1;
+  static constexpr size_t N_LEVELS = 4;
+  static constexpr size_t DUE_SLOT = N_LEVELS * N_SLOTS_PER_LEVEL; ///< timers expiring now
+
+  ExpireCallback m_expire;
+  time::nanoseconds m_resolution;
+  time::steady_clock::TimePoint m_origin;
+  uint64_t m_currentTick = 0;
+
+  std::array<Timer*, DUE_SLOT + 1> m_slots{};
+  std::bitset<N_SLOTS_PER_LEVEL> m_isLevel0Occupied;
+  size_t m_size = 0;
+
+  scheduler::ScopedEventId m_tickEvent;
+  time::steady_clock::TimePoint m_nextTickTime = time::steady_clock::TimePoint::max();
+  bool m_isAdvancing = false;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
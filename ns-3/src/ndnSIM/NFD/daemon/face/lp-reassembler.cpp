@@ -34,12 +34,63 @@ namespace face {
 
 NFD_LOG_INIT(LpReassembler);
 
+const size_t LpReassembler::EMPTY_SLOT = std::numeric_limits<size_t>::max();
+
+/** \brief reads the Fragment field of an lp::Packet as the TLV element itself
+ *
+ *  Unlike lp::FragmentField, the value keeps a reference to the buffer of the packet.
+ */
+struct FragmentElementField
+{
+  using TlvType = std::integral_constant<uint64_t, lp::tlv::Fragment>;
+  using ValueType = Block;
+
+  static Block
+  decode(const Block& wire)
+  {
+    return wire;
+  }
+};
+
+static Block
+getFragment(const lp::Packet& packet)
+{
+  return packet.get<FragmentElementField>();
+}
+
+/** \brief parse the TLV element at the beginning of [begin, end) without copying it
+ *  \throw tlv::Error the element is truncated
+ */
+static Block
+parseNetPacket(ndn::ConstBufferPtr buffer, ndn::Buffer::const_iterator begin,
+               ndn::Buffer::const_iterator end)
+{
+  auto pos = begin;
+  uint32_t type = tlv::readType(pos, end);
+  uint64_t length = tlv::readVarNumber(pos, end);
+  if (length > static_cast<uint64_t>(std::distance(pos, end))) {
+    NDN_THROW(tlv::Error("Not enough bytes in the buffer to fully parse TLV"));
+  }
+  return Block(std::move(buffer), type, begin, pos + length, pos, pos + length);
+}
+
 LpReassembler::LpReassembler(const LpReassembler::Options& options, const LinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
+  , m_dropTimers([this] (PartialPacket& pp) { timeoutPartialPacket(pp); })
 {
 }
 
+void
+LpReassembler::setOptions(const Options& options)
+{
+  bool isResized = options.nMaxPartialPackets != m_options.nMaxPartialPackets;
+  m_options = options;
+  if (isResized && !m_partialPackets.empty()) {
+    this->resetTable();
+  }
+}
+
 std::tuple<bool, Block, lp::Packet>
 LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& packet)
 {
@@ -69,9 +120,8 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
 
   // check for fast path
   if (fragIndex == 0 && fragCount == 1) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = packet.get<lp::FragmentField>();
-    Block netPkt(&*fragBegin, std::distance(fragBegin, fragEnd));
+    Block fragment = getFragment(packet);
+    Block netPkt = parseNetPacket(fragment.getBuffer(), fragment.value_begin(), fragment.value_end());
     return std::make_tuple(true, netPkt, packet);
   }
 
@@ -83,76 +133,141 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
   Key key = std::make_tuple(remoteEndpoint, messageIdentifier);
 
-  // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
-    pp.fragCount = fragCount;
-    pp.nReceivedFragments = 0;
-    pp.fragments.resize(fragCount);
+  // find or add PartialPacket
+  if (m_partialPackets.empty()) {
+    this->resetTable();
   }
-  else {
-    if (fragCount != pp.fragCount) {
-      NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+  size_t slot = this->findSlot(key);
+  if (m_index[slot] == EMPTY_SLOT) {
+    if (m_freePartialPackets.empty()) {
+      NFD_LOG_FACE_WARN("reassembly error, too many partial packets: DROP");
       return FALSE_RETURN;
     }
+    m_index[slot] = m_freePartialPackets.back();
+    m_freePartialPackets.pop_back();
+    ++m_nPartialPackets;
+
+    PartialPacket& pp = m_partialPackets[m_index[slot]];
+    pp.key = key;
+    pp.fragCount = fragCount;
+    pp.nReceivedFragments = 0;
+    pp.fragments.assign(fragCount, Block());
+  }
+  PartialPacket& pp = m_partialPackets[m_index[slot]];
+  if (fragCount != pp.fragCount) {
+    NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+    return FALSE_RETURN;
   }
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
+  if (pp.fragments[fragIndex].isValid()) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
     return FALSE_RETURN;
   }
 
-  pp.fragments[fragIndex] = packet;
+  pp.fragments[fragIndex] = getFragment(packet);
+  if (fragIndex == 0) {
+    pp.firstFragment = packet;
+  }
   ++pp.nReceivedFragments;
 
   // check complete condition
   if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
+    Block reassembled = doReassembly(pp);
+    lp::Packet firstFrag(std::move(pp.firstFragment));
+    this->erase(slot);
     return std::make_tuple(true, reassembled, firstFrag);
   }
 
   // set drop timer
-  pp.dropTimer = getScheduler().schedule(m_options.reassemblyTimeout, [=] { timeoutPartialPacket(key); });
+  m_dropTimers.schedule(pp.dropTimer, m_options.reassemblyTimeout);
 
   return FALSE_RETURN;
 }
 
-Block
-LpReassembler::doReassembly(const Key& key)
+size_t
+LpReassembler::hashKey(const Key& key)
+{
+  uint64_t h = std::get<1>(key) * 0x9E3779B97F4A7C15ULL ^ std::get<0>(key);
+  return static_cast<size_t>(h ^ (h >> 32));
+}
+
+size_t
+LpReassembler::findSlot(const Key& key) const
+{
+  size_t mask = m_index.size() - 1;
+  for (size_t slot = hashKey(key) & mask; ; slot = (slot + 1) & mask) {
+    if (m_index[slot] == EMPTY_SLOT || m_partialPackets[m_index[slot]].key == key) {
+      return slot;
+    }
+  }
+}
+
+void
+LpReassembler::erase(size_t slot)
 {
-  PartialPacket& pp = m_partialPackets[key];
+  PartialPacket& pp = m_partialPackets[m_index[slot]];
+  pp.dropTimer.cancel();
+  pp.fragCount = 0;
+  pp.fragments.clear(); // keeps capacity for the next partial packet
+  pp.firstFragment = lp::Packet();
+  m_freePartialPackets.push_back(m_index[slot]);
+  --m_nPartialPackets;
 
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0U,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      ndn::Buffer::const_iterator fragBegin, fragEnd;
-      std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
+  // shift back later slots of the same probe sequence, so that lookups need no tombstones
+  size_t mask = m_index.size() - 1;
+  size_t hole = slot;
+  for (size_t next = (hole + 1) & mask; m_index[next] != EMPTY_SLOT; next = (next + 1) & mask) {
+    size_t home = hashKey(m_partialPackets[m_index[next]].key) & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      m_index[hole] = m_index[next];
+      hole = next;
+    }
+  }
+  m_index[hole] = EMPTY_SLOT;
+}
+
+void
+LpReassembler::resetTable()
+{
+  size_t nSlots = 1;
+  while (nSlots < 2 * m_options.nMaxPartialPackets) {
+    nSlots <<= 1;
+  }
+
+  std::vector<PartialPacket>(m_options.nMaxPartialPackets).swap(m_partialPackets);
+  m_freePartialPackets.resize(m_options.nMaxPartialPackets);
+  std::iota(m_freePartialPackets.rbegin(), m_freePartialPackets.rend(), 0);
+  m_index.assign(nSlots, EMPTY_SLOT);
+  m_nPartialPackets = 0;
+}
+
+Block
+LpReassembler::doReassembly(const PartialPacket& pp)
+{
+  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), size_t(0),
+    [] (size_t sum, const Block& fragment) -> size_t {
+      return sum + fragment.value_size();
     });
 
-  ndn::Buffer fragBuffer(payloadSize);
-  auto it = fragBuffer.begin();
+  auto fragBuffer = make_shared<ndn::Buffer>(payloadSize);
+  auto it = fragBuffer->begin();
 
-  for (const lp::Packet& frag : pp.fragments) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
+  for (const Block& fragment : pp.fragments) {
+    it = std::copy(fragment.value_begin(), fragment.value_end(), it);
   }
 
-  return Block(&*(fragBuffer.cbegin()), std::distance(fragBuffer.cbegin(), fragBuffer.cend()));
+  // the network-layer packet is decoded from the gathered buffer without another copy
+  return parseNetPacket(fragBuffer, fragBuffer->cbegin(), fragBuffer->cend());
 }
 
 void
-LpReassembler::timeoutPartialPacket(const Key& key)
+LpReassembler::timeoutPartialPacket(PartialPacket& pp)
 {
-  auto it = m_partialPackets.find(key);
-  if (it == m_partialPackets.end()) {
-    return;
-  }
+  size_t slot = this->findSlot(pp.key);
+  BOOST_ASSERT(m_index[slot] != EMPTY_SLOT);
 
-  this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
-  m_partialPackets.erase(it);
+  this->beforeTimeout(std::get<0>(pp.key), pp.nReceivedFragments);
+  this->erase(slot);
 }
 
 std::ostream&
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_LP_REASSEMBLER_HPP
 
 #include "face-common.hpp"
+#include "common/timer-wheel.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 
@@ -52,6 +53,13 @@ public:
     /** \brief timeout before a partially reassembled packet is dropped
      */
     time::nanoseconds reassemblyTimeout = 500_ms;
+
+    /** \brief maximum number of partially reassembled packets
+     *
+     *  A fragment that would start a new partial packet beyond this limit is dropped.
+     *  Changing this limit drops all partial packets.
+     */
+    size_t nMaxPartialPackets = 256;
   };
 
   explicit
@@ -70,6 +78,9 @@ public:
   getLinkService() const;
 
   /** \brief adds received fragment to the buffer
+   *
+   *  The reassembled network-layer packet shares the buffer of \p packet if it has only one
+   *  fragment, and otherwise a buffer into which all fragments are copied once.
    *  \param remoteEndpoint endpoint that sent the packet
    *  \param packet received fragment; must have Fragment field
    *  \return a tuple containing:
@@ -96,16 +107,6 @@ public:
   signal::Signal<LpReassembler, EndpointId, size_t> beforeTimeout;
 
 private:
-  /** \brief holds all fragments of packet until reassembled
-   */
-  struct PartialPacket
-  {
-    std::vector<lp::Packet> fragments;
-    size_t fragCount; ///< total fragments
-    size_t nReceivedFragments; ///< number of received fragments
-    scheduler::ScopedEventId dropTimer;
-  };
-
   /** \brief index key for PartialPackets
    */
   typedef std::tuple<
@@ -113,27 +114,70 @@ private:
     lp::Sequence // message identifier (sequence of the first fragment)
   > Key;
 
+  /** \brief holds all fragments of packet until reassembled
+   *
+   *  PartialPackets are allocated once, up to Options::nMaxPartialPackets, and reused.
+   */
+  struct PartialPacket : noncopyable
+  {
+    PartialPacket()
+      : dropTimer(*this)
+    {
+    }
+
+    Key key;
+    std::vector<Block> fragments; ///< Fragment elements, sharing the buffers of received packets
+    lp::Packet firstFragment;
+    size_t fragCount = 0; ///< total fragments, 0 if unused
+    size_t nReceivedFragments = 0; ///< number of received fragments
+    TimerWheel<PartialPacket>::Timer dropTimer;
+  };
+
+  static size_t
+  hashKey(const Key& key);
+
+  /** \return slot of m_index that refers to the PartialPacket of \p key, or an empty slot
+   */
+  size_t
+  findSlot(const Key& key) const;
+
+  /** \brief release the PartialPacket referred to by \p slot
+   */
+  void
+  erase(size_t slot);
+
+  /** \brief drop all partial packets and size the table for Options::nMaxPartialPackets
+   */
+  void
+  resetTable();
+
   Block
-  doReassembly(const Key& key);
+  doReassembly(const PartialPacket& pp);
 
   void
-  timeoutPartialPacket(const Key& key);
+  timeoutPartialPacket(PartialPacket& pp);
 
 private:
   Options m_options;
   const LinkService* m_linkService;
-  std::map<Key, PartialPacket> m_partialPackets;
+
+  TimerWheel<PartialPacket> m_dropTimers;
+  std::vector<PartialPacket> m_partialPackets; ///< allocated on first use
+  std::vector<size_t> m_freePartialPackets; ///< indices of unused m_partialPackets
+  /** \brief open addressing hashtable of indices into m_partialPackets
+   *
+   *  It has at least twice as many slots as Options::nMaxPartialPackets, and collisions are
+   *  resolved by linear probing.
+   */
+  std::vector<size_t> m_index;
+  size_t m_nPartialPackets = 0;
+
+  static const size_t EMPTY_SLOT;
 };
 
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LpReassembler>& flh);
 
-inline void
-LpReassembler::setOptions(const Options& options)
-{
-  m_options = options;
-}
-
 inline const LinkService*
 LpReassembler::getLinkService() const
 {
@@ -143,7 +187,7 @@ LpReassembler::getLinkService() const
 inline size_t
 LpReassembler::size() const
 {
-  return m_partialPackets.size();
+  return m_nPartialPackets;
 }
 
 } // namespace face
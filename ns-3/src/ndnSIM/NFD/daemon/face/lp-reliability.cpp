@@ -34,7 +34,6 @@ namespace face {
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
 {
   BOOST_ASSERT(m_linkService != nullptr);
@@ -64,10 +63,10 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
+  auto rtoExpiry = sendTime + m_rttEst.getEstimatedRto();
 
-  auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
+  NetPkt* netPkt = allocateNetPkt(std::move(pkt), isInterest);
   netPkt->unackedFrags.reserve(frags.size());
 
   for (lp::Packet& frag : frags) {
@@ -75,22 +74,16 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.emplace_hint(unackedFragsIt,
-                                                 std::piecewise_construct,
-                                                 std::forward_as_tuple(txSeq),
-                                                 std::forward_as_tuple(frag));
-    unackedFragsIt->second.sendTime = sendTime;
-    unackedFragsIt->second.rtoTimer = getScheduler().schedule(m_rttEst.getEstimatedRto(),
-                                                              [=] { onLpPacketLost(txSeq); });
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
+    UnackedFrag& unackedFrag = m_unackedFrags.emplace(txSeq, frag);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.rtoExpiry = rtoExpiry;
+    unackedFrag.netPkt = netPkt;
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
   }
+
+  startRtoTimer(rtoExpiry);
 }
 
 void
@@ -98,49 +91,49 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto now = time::steady_clock::now();
+  if (!m_unackedFrags.empty() && pkt.has<lp::AckField>()) {
+    auto now = time::steady_clock::now();
+    lp::Sequence windowBegin = m_unackedFrags.getFirstSequence();
+    m_ackedOffsets.clear();
+
+    // Extract and parse Acks
+    for (lp::Sequence ackSeq : pkt.list<lp::AckField>()) {
+      UnackedFrag* frag = m_unackedFrags.find(ackSeq);
+      if (frag == nullptr) {
+        // Ignore an Ack for an unknown TxSequence number
+        continue;
+      }
 
-  // Extract and parse Acks
-  for (lp::Sequence ackSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackSeq);
-    if (fragIt == m_unackedFrags.end()) {
-      // Ignore an Ack for an unknown TxSequence number
-      continue;
-    }
-    auto& frag = fragIt->second;
+      if (frag->retxCount == 0) {
+        // This sequence had no retransmissions, so use it to estimate the RTO
+        m_rttEst.addMeasurement(now - frag->sendTime);
+      }
 
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
+      m_ackedOffsets.push_back(ackSeq - windowBegin);
 
-    if (frag.retxCount == 0) {
-      // This sequence had no retransmissions, so use it to estimate the RTO
-      m_rttEst.addMeasurement(now - frag.sendTime);
+      // Remove the fragment from the unacknowledged fragments and from its associated network
+      // packet. Potentially increment the start of the window.
+      onLpPacketAcknowledged(ackSeq);
     }
 
-    // Look for frags with TxSequence numbers < ackSeq (allowing for wraparound) and consider them
-    // lost if a configurable number of Acks containing greater TxSequence numbers have been
-    // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
-
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
-
-    // This set contains TxSequences that have been removed by onLpPacketLost below because they
-    // were part of a network packet that was removed due to a fragment exceeding retx, as well as
-    // any other TxSequences removed by onLpPacketLost. This prevents onLpPacketLost from being
-    // called later for an invalid iterator.
-    std::set<lp::Sequence> removedLpPackets;
-
-    // Resend or fail fragments considered lost. Potentially increment the start of the window.
-    for (lp::Sequence txSeq : lostLpPackets) {
-      if (removedLpPackets.find(txSeq) == removedLpPackets.end()) {
-        auto removedThisTxSeq = onLpPacketLost(txSeq);
-        for (auto removedTxSeq : removedThisTxSeq) {
-          removedLpPackets.insert(removedTxSeq);
+    if (!m_ackedOffsets.empty()) {
+      // Look for frags with TxSequence numbers before the acknowledged ones (allowing for
+      // wraparound) and consider them lost if a configurable number of Acks containing greater
+      // TxSequence numbers have been received.
+      auto lostLpPackets = findLostLpPackets(windowBegin, m_ackedOffsets);
+
+      // Resend or fail fragments considered lost. A fragment may already have been removed if
+      // another fragment of the same network packet exceeded the retransmission limit.
+      for (lp::Sequence txSeq : lostLpPackets) {
+        if (m_unackedFrags.count(txSeq) > 0) {
+          onLpPacketLost(txSeq);
         }
       }
     }
+
+    if (m_unackedFrags.empty()) {
+      m_rtoTimer.cancel();
+    }
   }
 
   // If packet has Fragment and TxSequence fields, extract TxSequence and add to AckQueue
@@ -185,7 +178,7 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (m_unackedFrags.size() > 0 && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstSequence()) {
     NDN_THROW(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
@@ -206,50 +199,95 @@ LpReliability::startIdleAckTimer()
   });
 }
 
+void
+LpReliability::startRtoTimer(time::steady_clock::TimePoint expiry)
+{
+  if (m_rtoTimer && m_rtoTimerExpiry <= expiry) {
+    // timer will fire early enough, do nothing
+    return;
+  }
+
+  m_rtoTimerExpiry = expiry;
+  m_rtoTimer = getScheduler().schedule(expiry - time::steady_clock::now(), [this] { onRtoTimeout(); });
+}
+
+void
+LpReliability::onRtoTimeout()
+{
+  // Walk the window once, resending expired fragments and looking for the earliest expiration
+  // among the others. Retransmissions are appended to the window, so the walk also reaches them.
+  // Fragments acknowledged since the timer was started leave it behind with a stale expiration,
+  // which is why the timer is always rescheduled from this walk.
+  auto now = time::steady_clock::now();
+  auto nextExpiry = time::steady_clock::TimePoint::max();
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstSequence();
+       !m_unackedFrags.empty() && txSeq != m_unackedFrags.getEndSequence(); ++txSeq) {
+    const UnackedFrag* frag = m_unackedFrags.find(txSeq);
+    if (frag == nullptr) {
+      // acknowledged, or removed with another fragment of its network packet
+      continue;
+    }
+
+    if (frag->rtoExpiry <= now) {
+      onLpPacketLost(txSeq);
+    }
+    else {
+      nextExpiry = std::min(nextExpiry, frag->rtoExpiry);
+    }
+  }
+
+  m_rtoTimer.cancel();
+  if (!m_unackedFrags.empty()) {
+    startRtoTimer(nextExpiry);
+  }
+}
+
 std::vector<lp::Sequence>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+LpReliability::findLostLpPackets(lp::Sequence windowBegin, std::vector<lp::Sequence>& ackedOffsets)
 {
   std::vector<lp::Sequence> lostLpPackets;
+  if (m_unackedFrags.empty()) {
+    return lostLpPackets;
+  }
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
-    }
+  std::sort(ackedOffsets.begin(), ackedOffsets.end());
 
-    if (it->first == ackIt->first) {
-      break;
+  // Every fragment preceding an acknowledged one in the window is credited with one greater Ack.
+  // Walking the window and the sorted offsets together counts all Acks of the packet at once.
+  auto nextAck = ackedOffsets.begin();
+  for (lp::Sequence offset = m_unackedFrags.getFirstSequence() - windowBegin;
+       offset < ackedOffsets.back(); ++offset) {
+    while (*nextAck <= offset) {
+      ++nextAck;
     }
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
+    lp::Sequence txSeq = windowBegin + offset;
+    UnackedFrag* frag = m_unackedFrags.find(txSeq);
+    if (frag == nullptr) {
+      continue;
+    }
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it->first);
+    frag->nGreaterSeqAcks += std::distance(nextAck, ackedOffsets.end());
+    if (frag->nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
+      lostLpPackets.push_back(txSeq);
     }
   }
 
   return lostLpPackets;
 }
 
-std::vector<lp::Sequence>
+void
 LpReliability::onLpPacketLost(lp::Sequence txSeq)
 {
   BOOST_ASSERT(m_unackedFrags.count(txSeq) > 0);
-  auto txSeqIt = m_unackedFrags.find(txSeq);
-
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
-  auto netPkt = txFrag.netPkt;
-  std::vector<lp::Sequence> removedThisTxSeq;
+  UnackedFrag* txFrag = m_unackedFrags.find(txSeq);
+  NetPkt* netPkt = txFrag->netPkt;
 
   // Check if maximum number of retransmissions exceeded
-  if (txFrag.retxCount >= m_options.maxRetx) {
-    // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        removedThisTxSeq.push_back(netPkt->unackedFrags[i]->first);
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
-      }
+  if (txFrag->retxCount >= m_options.maxRetx) {
+    // Delete all LpPackets of NetPkt from m_unackedFrags
+    for (lp::Sequence fragSeq : netPkt->unackedFrags) {
+      m_unackedFrags.erase(fragSeq);
     }
 
     ++m_linkService->nRetxExhausted;
@@ -263,52 +301,42 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq)
       onDroppedInterest(Interest(frag));
     }
 
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    releaseNetPkt(netPkt);
   }
   else {
     // Assign new TxSequence
-    lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
+    lp::Sequence newTxSeq = assignTxSequence(txFrag->pkt);
     netPkt->didRetx = true;
 
     // Move fragment to new TxSequence mapping
-    auto newTxFragIt = m_unackedFrags.emplace_hint(
-      m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-        ? m_firstUnackedFrag
-        : m_unackedFrags.end(),
-      std::piecewise_construct,
-      std::forward_as_tuple(newTxSeq),
-      std::forward_as_tuple(txFrag.pkt));
-    auto& newTxFrag = newTxFragIt->second;
-    newTxFrag.retxCount = txFrag.retxCount + 1;
+    size_t retxCount = txFrag->retxCount + 1;
+    UnackedFrag& newTxFrag = m_unackedFrags.emplace(newTxSeq, std::move(txFrag->pkt));
+    newTxFrag.retxCount = retxCount;
+    newTxFrag.rtoExpiry = newTxFrag.sendTime + m_rttEst.getEstimatedRto();
     newTxFrag.netPkt = netPkt;
 
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
+    *fragInNetPkt = newTxSeq;
 
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    m_unackedFrags.erase(txSeq);
 
     // Retransmit fragment
     m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt), 0);
 
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = getScheduler().schedule(m_rttEst.getEstimatedRto(),
-                                                 [=] { onLpPacketLost(newTxSeq); });
+    // Make sure the RTO timer covers this sequence
+    startRtoTimer(newTxFrag.rtoExpiry);
   }
-
-  return removedThisTxSeq;
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  NetPkt* netPkt = m_unackedFrags.at(txSeq).netPkt;
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
+  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
   BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
   *fragInNetPkt = netPkt->unackedFrags.back();
   netPkt->unackedFrags.pop_back();
@@ -321,30 +349,118 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     else {
       ++m_linkService->nAcknowledged;
     }
+    releaseNetPkt(netPkt);
   }
 
-  deleteUnackedFrag(fragIt);
+  m_unackedFrags.erase(txSeq);
+}
+
+LpReliability::NetPkt*
+LpReliability::allocateNetPkt(lp::Packet&& pkt, bool isInterest)
+{
+  if (m_freeNetPkts.empty()) {
+    m_netPkts.emplace_back(std::move(pkt), isInterest);
+    return &m_netPkts.back();
+  }
+
+  NetPkt* netPkt = m_freeNetPkts.back();
+  m_freeNetPkts.pop_back();
+  netPkt->pkt = std::move(pkt);
+  netPkt->isInterest = isInterest;
+  netPkt->didRetx = false;
+  return netPkt;
 }
 
 void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
+LpReliability::releaseNetPkt(NetPkt* netPkt)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
+  // keep the capacity of unackedFrags for the next network packet
+  netPkt->unackedFrags.clear();
+  netPkt->pkt = lp::Packet();
+  m_freeNetPkts.push_back(netPkt);
+}
+
+const LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq) const
+{
+  // unsigned arithmetic takes care of TxSequence wraparound
+  if (txSeq - m_first >= m_end - m_first) {
+    return nullptr;
+  }
+
+  const auto& slot = m_slots[txSeq & (m_slots.size() - 1)];
+  return slot ? &*slot : nullptr;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq)
+{
+  UnackedFrag* frag = find(txSeq);
+  if (frag == nullptr) {
+    NDN_THROW(std::out_of_range("TxSequence " + to_string(txSeq) + " is not unacknowledged"));
+  }
+  return *frag;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::emplace(lp::Sequence txSeq, lp::Packet pkt)
+{
+  if (empty()) {
+    m_first = m_end = txSeq;
   }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
+  BOOST_ASSERT(txSeq - m_first >= m_end - m_first);
+
+  lp::Sequence newWindowSize = txSeq - m_first + 1;
+  if (newWindowSize > m_slots.size()) {
+    grow(newWindowSize);
+  }
+
+  auto& slot = m_slots[txSeq & (m_slots.size() - 1)];
+  BOOST_ASSERT(!slot);
+  slot.emplace(std::move(pkt));
+  m_end = txSeq + 1;
+  ++m_size;
+  return *slot;
+}
+
+void
+LpReliability::UnackedFrags::erase(lp::Sequence txSeq)
+{
+  BOOST_ASSERT(find(txSeq) != nullptr);
+  size_t mask = m_slots.size() - 1;
+  m_slots[txSeq & mask] = nullopt;
+  --m_size;
+
+  if (empty()) {
+    m_first = m_end;
+    return;
+  }
+
+  // If "first" fragment in send window (allowing for wraparound), increment window begin
+  if (txSeq == m_first) {
+    do {
+      ++m_first;
+    } while (!m_slots[m_first & mask]);
+  }
+}
+
+void
+LpReliability::UnackedFrags::grow(size_t minCapacity)
+{
+  size_t capacity = std::max<size_t>(m_slots.size(), 16);
+  while (capacity < minCapacity) {
+    capacity *= 2;
+  }
+
+  std::vector<optional<UnackedFrag>> slots(capacity);
+  size_t oldMask = m_slots.size() - 1;
+  for (lp::Sequence txSeq = m_first; txSeq != m_end; ++txSeq) {
+    auto& slot = m_slots[txSeq & oldMask];
+    if (slot) {
+      slots[txSeq & (capacity - 1)] = std::move(slot);
+    }
   }
+  m_slots = std::move(slots);
 }
 
 LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
@@ -352,6 +468,7 @@ LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
   , sendTime(time::steady_clock::now())
   , retxCount(0)
   , nGreaterSeqAcks(0)
+  , netPkt(nullptr)
 {
 }
 
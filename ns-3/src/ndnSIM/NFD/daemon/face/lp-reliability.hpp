@@ -32,6 +32,7 @@
 #include <ndn-cxx/lp/sequence.hpp>
 #include <ndn-cxx/util/rtt-estimator.hpp>
 
+#include <deque>
 #include <queue>
 
 namespace nfd {
@@ -106,8 +107,8 @@ public:
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
+  class UnackedFrags;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief assign TxSequence number to a fragment
@@ -127,39 +128,57 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   startIdleAckTimer();
 
+  /** \brief make sure the RTO timer fires no later than \p expiry
+   *
+   *  A single timer covers all unacknowledged fragments of the link. It is only rescheduled if
+   *  \p expiry is earlier than the currently scheduled expiration.
+   */
+  void
+  startRtoTimer(time::steady_clock::TimePoint expiry);
+
+  /** \brief resend (or give up on) every fragment whose RTO has expired, then reschedule the RTO
+   *         timer for the earliest remaining expiration
+   */
+  void
+  onRtoTimeout();
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
+   *  \param windowBegin start of the send window when the Acks were received
+   *  \param ackedOffsets offsets from \p windowBegin of the fragments acknowledged in one
+   *                      LpPacket; they are sorted by this function
    *  \return vector containing TxSequences of fragments marked lost by this mechanism
+   *
+   *  All Acks of an incoming LpPacket are accounted for in one pass over the send window.
    */
   std::vector<lp::Sequence>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  findLostLpPackets(lp::Sequence windowBegin, std::vector<lp::Sequence>& ackedOffsets);
 
   /** \brief resend (or give up on) a lost fragment
-   *  \return vector of the TxSequences of fragments removed due to a network packet being removed
+   *  \pre \p txSeq is in m_unackedFrags
    */
-  std::vector<lp::Sequence>
+  void
   onLpPacketLost(lp::Sequence txSeq);
 
-  /** \brief remove the fragment with the given sequence number from the map of unacknowledged
-   *         fragments, as well as its associated network packet (if any)
-   *  \param fragIt iterator to acknowledged fragment
+  /** \brief remove the fragment with the given sequence number from the unacknowledged
+   *         fragments, as well as from its associated network packet
+   *  \param txSeq TxSequence of the acknowledged fragment
    *
    *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
-   *  If the associated network packet has been fully transmitted, it will be removed.
+   *  If the associated network packet has been fully transmitted, it will be released.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
+
+  /** \brief take a network packet record from the pool
+   */
+  NetPkt*
+  allocateNetPkt(lp::Packet&& pkt, bool isInterest);
 
-  /** \brief delete a fragment from UnackedFrags and advance acknowledge window if necessary
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
+  /** \brief return a network packet record to the pool
    */
   void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  releaseNetPkt(NetPkt* netPkt);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief contains a sent fragment that has not been acknowledged and associated data
@@ -172,14 +191,101 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   public:
     lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
     time::steady_clock::TimePoint sendTime;
+    time::steady_clock::TimePoint rtoExpiry;
     size_t retxCount;
     size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
-    shared_ptr<NetPkt> netPkt;
+    NetPkt* netPkt;
+  };
+
+  /** \brief unacknowledged fragments, indexed by TxSequence
+   *
+   *  TxSequence numbers are assigned in increasing order, so the send window is kept in a
+   *  circular buffer where the fragment with TxSequence \c seq lives in slot \c seq modulo the
+   *  (power of two) capacity. Lookup, insertion and removal are constant time. The capacity
+   *  doubles whenever the window outgrows it, and is never reduced.
+   */
+  class UnackedFrags : noncopyable
+  {
+  public:
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    size_t
+    count(lp::Sequence txSeq) const
+    {
+      return find(txSeq) != nullptr;
+    }
+
+    /** \return fragment with TxSequence \p txSeq, or nullptr if it is not in the window
+     */
+    const UnackedFrag*
+    find(lp::Sequence txSeq) const;
+
+    UnackedFrag*
+    find(lp::Sequence txSeq)
+    {
+      return const_cast<UnackedFrag*>(const_cast<const UnackedFrags*>(this)->find(txSeq));
+    }
+
+    /** \throw std::out_of_range \p txSeq is not in the window
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq);
+
+    /** \return TxSequence of the first unacknowledged fragment, allowing for wraparound
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstSequence() const
+    {
+      BOOST_ASSERT(!empty());
+      return m_first;
+    }
+
+    /** \return TxSequence after the last fragment in the window
+     */
+    lp::Sequence
+    getEndSequence() const
+    {
+      return m_end;
+    }
+
+    /** \brief insert a fragment at the end of the window
+     *  \pre \p txSeq is not before the end of a non-empty window
+     */
+    UnackedFrag&
+    emplace(lp::Sequence txSeq, lp::Packet pkt);
+
+    /** \brief remove a fragment, advancing the start of the window if necessary
+     *  \pre \p txSeq is in the window
+     */
+    void
+    erase(lp::Sequence txSeq);
+
+  private:
+    void
+    grow(size_t minCapacity);
+
+  private:
+    std::vector<optional<UnackedFrag>> m_slots;
+    lp::Sequence m_first = 0;
+    lp::Sequence m_end = 0;
+    size_t m_size = 0;
   };
 
   /** \brief contains a network-layer packet with unacknowledged fragments
+   *
+   *  Records are pooled by LpReliability and reused for later network packets.
    */
   class NetPkt
   {
@@ -187,7 +293,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     NetPkt(lp::Packet&& pkt, bool isInterest);
 
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
+    std::vector<lp::Sequence> unackedFrags;
     lp::Packet pkt;
     bool isInterest;
     bool didRetx;
@@ -203,15 +309,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Options m_options;
   GenericLinkService* m_linkService;
   UnackedFrags m_unackedFrags;
-  /** An iterator that points to the first unacknowledged fragment in the current window. The window
-   *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
-   */
-  UnackedFrags::iterator m_firstUnackedFrag;
+  std::deque<NetPkt> m_netPkts; //!< owns all NetPkt records, in use or not
+  std::vector<NetPkt*> m_freeNetPkts;
+  std::vector<lp::Sequence> m_ackedOffsets; //!< scratch space for processIncomingPacket
   std::queue<lp::Sequence> m_ackQueue;
   lp::Sequence m_lastTxSeqNo;
   scheduler::ScopedEventId m_idleAckTimer;
+  scheduler::ScopedEventId m_rtoTimer;
+  time::steady_clock::TimePoint m_rtoTimerExpiry;
   ndn::util::RttEstimator m_rttEst;
 };
 
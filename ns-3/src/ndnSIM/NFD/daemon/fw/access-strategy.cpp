@@ -270,7 +270,7 @@ AccessStrategy::addPrefixMeasurements(const Data& data)
 {
   measurements::Entry* me = nullptr;
   if (!data.getName().empty()) {
-    me = this->getMeasurements().get(data.getName().getPrefix(-1));
+    me = this->getMeasurements().get(PrefixView(data.getName(), data.getName().size() - 1));
   }
   if (me == nullptr) { // parent of Data Name is not in this strategy, or Data Name is empty
     me = this->getMeasurements().get(data.getName());
@@ -129,7 +129,7 @@ AsfMeasurements::getOrCreateNamespaceInfo(const fib::Entry& fibEntry, const Inte
   // that falls under the strategy's namespace
   for (size_t prefixLen = fibEntry.getPrefix().size() + 1;
        me == nullptr && prefixLen <= interest.getName().size(); ++prefixLen) {
-    me = m_measurements.get(interest.getName().getPrefix(prefixLen));
+    me = m_measurements.get(PrefixView(interest.getName(), prefixLen));
   }
 
   // Either the FIB entry or the Interest's name must be under this strategy's namespace
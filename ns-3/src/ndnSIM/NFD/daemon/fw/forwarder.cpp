@@ -46,28 +46,66 @@ getDefaultStrategyName()
   return fw::BestRouteStrategy2::getStrategyName();
 }
 
-Forwarder::Forwarder(FaceTable& faceTable)
+/** \brief reorder \p accepted so that the packets of each name are adjacent
+ *
+ *  Packets of one name keep their arrival order, and each group is placed at the arrival of
+ *  its first packet, so packets of different names are only reordered past later arrivals
+ *  of a name that was seen earlier.
+ */
+template<typename Batch>
+static void
+groupByName(const Batch& batch, std::vector<size_t>& accepted)
+{
+  std::unordered_map<name_tree::HashValue, size_t> groupOf;
+  std::vector<std::pair<size_t, size_t>> grouped; // group, index in batch
+  grouped.reserve(accepted.size());
+  for (size_t i : accepted) {
+    size_t group = groupOf.emplace(name_tree::getHashes(*batch[i].packet).back(), groupOf.size()).first->second;
+    grouped.emplace_back(group, i);
+  }
+
+  std::stable_sort(grouped.begin(), grouped.end(),
+                   [] (const auto& a, const auto& b) { return a.first < b.first; });
+  for (size_t j = 0; j < grouped.size(); ++j) {
+    accepted[j] = grouped[j].second;
+  }
+}
+
+Forwarder::Forwarder(FaceTable& faceTable, const name_tree::HashtableOptions& nameTreeOptions)
   : m_faceTable(faceTable)
   , m_unsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>())
+  , m_nameTree(nameTreeOptions)
   , m_fib(m_nameTree)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
   , m_strategyChoice(*this)
   , m_csFace(face::makeNullFace(FaceUri("contentstore://")))
+  , m_pitExpiryWheel([this] (pit::Entry& pitEntry) { onInterestFinalize(pitEntry.shared_from_this()); })
 {
   m_faceTable.addReserved(m_csFace, face::FACEID_CONTENT_STORE);
 
   m_faceTable.afterAdd.connect([this] (const Face& face) {
     face.afterReceiveInterest.connect(
       [this, &face] (const Interest& interest, const EndpointId& endpointId) {
-        this->startProcessInterest(FaceEndpoint(face, endpointId), interest);
+        if (m_isBatchingEnabled) {
+          this->enqueueInterest(FaceEndpoint(face, endpointId), interest);
+        }
+        else {
+          this->startProcessInterest(FaceEndpoint(face, endpointId), interest);
+        }
       });
     face.afterReceiveData.connect(
       [this, &face] (const Data& data, const EndpointId& endpointId) {
-        this->startProcessData(FaceEndpoint(face, endpointId), data);
+        if (m_isBatchingEnabled) {
+          this->enqueueData(FaceEndpoint(face, endpointId), data);
+        }
+        else {
+          this->startProcessData(FaceEndpoint(face, endpointId), data);
+        }
       });
     face.afterReceiveNack.connect(
       [this, &face] (const lp::Nack& nack, const EndpointId& endpointId) {
+        this->flushBatch();
         this->startProcessNack(FaceEndpoint(face, endpointId), nack);
       });
     face.onDroppedInterest.connect(
@@ -77,6 +115,8 @@ Forwarder::Forwarder(FaceTable& faceTable)
   });
 
   m_faceTable.beforeRemove.connect([this] (const Face& face) {
+    // queued packets may refer to the face
+    this->flushBatch();
     cleanupOnFaceRemoval(m_nameTree, m_fib, m_pit, face);
   });
 
@@ -89,8 +129,123 @@ Forwarder::Forwarder(FaceTable& faceTable)
 
 Forwarder::~Forwarder() = default;
 
+void
+Forwarder::startProcessInterestBatch(const std::vector<IncomingInterest>& batch)
+{
+  NFD_LOG_DEBUG("startProcessInterestBatch size=" << batch.size());
+
+  // receive, scope control and Dead Nonce List; prefetch name tree buckets for PIT insert
+  std::vector<size_t> accepted;
+  accepted.reserve(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (this->acceptIncomingInterest(batch[i].ingress, *batch[i].packet)) {
+      m_nameTree.prefetch(name_tree::getHashes(*batch[i].packet));
+      accepted.push_back(i);
+    }
+  }
+
+  groupByName(batch, accepted);
+
+  // PIT insert
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+  pitEntries.reserve(accepted.size());
+  for (size_t i : accepted) {
+    pitEntries.push_back(this->insertIncomingInterest(batch[i].ingress, *batch[i].packet));
+  }
+
+  // PIT entries are only erased by their expiry timers, so they are all still valid here
+  for (size_t j = 0; j < accepted.size(); ++j) {
+    const IncomingInterest& incoming = batch[accepted[j]];
+    this->processIncomingInterest(incoming.ingress, *incoming.packet, pitEntries[j]);
+  }
+}
+
+void
+Forwarder::startProcessDataBatch(const std::vector<IncomingData>& batch)
+{
+  NFD_LOG_DEBUG("startProcessDataBatch size=" << batch.size());
+
+  // receive and scope control; prefetch name tree buckets for PIT match
+  std::vector<size_t> accepted;
+  accepted.reserve(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (this->acceptIncomingData(batch[i].ingress, *batch[i].packet)) {
+      m_nameTree.prefetch(name_tree::getHashes(*batch[i].packet));
+      accepted.push_back(i);
+    }
+  }
+
+  groupByName(batch, accepted);
+
+  for (size_t i : accepted) {
+    this->processIncomingData(batch[i].ingress, *batch[i].packet);
+  }
+}
+
+void
+Forwarder::enableBatching(bool isEnabled)
+{
+  if (!isEnabled) {
+    this->flushBatch();
+  }
+  m_isBatchingEnabled = isEnabled;
+}
+
+void
+Forwarder::enqueueInterest(const FaceEndpoint& ingress, const Interest& interest)
+{
+  if (!m_pendingData.empty()) {
+    this->flushBatch();
+  }
+  m_pendingInterests.push_back({ingress, interest.shared_from_this()});
+  if (!m_flushEvent) {
+    m_flushEvent = getScheduler().schedule(0_ns, [this] { flushBatch(); });
+  }
+}
+
+void
+Forwarder::enqueueData(const FaceEndpoint& ingress, const Data& data)
+{
+  if (!m_pendingInterests.empty()) {
+    this->flushBatch();
+  }
+  m_pendingData.push_back({ingress, data.shared_from_this()});
+  if (!m_flushEvent) {
+    m_flushEvent = getScheduler().schedule(0_ns, [this] { flushBatch(); });
+  }
+}
+
+void
+Forwarder::flushBatch()
+{
+  m_flushEvent.cancel();
+
+  // processing may send packets to local faces, which may enqueue more packets
+  if (!m_pendingInterests.empty()) {
+    std::vector<IncomingInterest> batch;
+    batch.swap(m_pendingInterests);
+    this->startProcessInterestBatch(batch);
+  }
+  if (!m_pendingData.empty()) {
+    std::vector<IncomingData> batch;
+    batch.swap(m_pendingData);
+    this->startProcessDataBatch(batch);
+  }
+}
+
 void
 Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& interest)
+{
+  if (!this->acceptIncomingInterest(ingress, interest)) {
+    return;
+  }
+
+  shared_ptr<pit::Entry> pitEntry = this->insertIncomingInterest(ingress, interest);
+  this->processIncomingInterest(ingress, interest, pitEntry);
+}
+
+bool
+Forwarder::acceptIncomingInterest(const FaceEndpoint& ingress, const Interest& interest)
 {
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest in=" << ingress << " interest=" << interest.getName());
@@ -104,7 +259,7 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
     NFD_LOG_DEBUG("onIncomingInterest in=" << ingress
                   << " interest=" << interest.getName() << " violates /localhost");
     // (drop)
-    return;
+    return false;
   }
 
   // detect duplicate Nonce with Dead Nonce List
@@ -112,9 +267,15 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
   if (hasDuplicateNonceInDnl) {
     // goto Interest loop pipeline
     this->onInterestLoop(ingress, interest);
-    return;
+    return false;
   }
 
+  return true;
+}
+
+shared_ptr<pit::Entry>
+Forwarder::insertIncomingInterest(const FaceEndpoint& ingress, const Interest& interest)
+{
   // strip forwarding hint if Interest has reached producer region
   if (!interest.getForwardingHint().empty() &&
       m_networkRegionTable.isInProducerRegion(interest.getForwardingHint())) {
@@ -124,8 +285,13 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
   }
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  return m_pit.insert(interest).first;
+}
 
+void
+Forwarder::processIncomingInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                   const shared_ptr<pit::Entry>& pitEntry)
+{
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), ingress.face);
   bool hasDuplicateNonceInPit = dnw != fw::DUPLICATE_NONCE_NONE;
@@ -284,6 +450,14 @@ Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry)
 
 void
 Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
+{
+  if (this->acceptIncomingData(ingress, data)) {
+    this->processIncomingData(ingress, data);
+  }
+}
+
+bool
+Forwarder::acceptIncomingData(const FaceEndpoint& ingress, const Data& data)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName());
@@ -296,9 +470,15 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
   if (isViolatingLocalhost) {
     NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName() << " violates /localhost");
     // (drop)
-    return;
+    return false;
   }
 
+  return true;
+}
+
+void
+Forwarder::processIncomingData(const FaceEndpoint& ingress, const Data& data)
+{
   // PIT match
   pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
   if (pitMatches.size() == 0) {
@@ -575,8 +755,7 @@ Forwarder::setExpiryTimer(const shared_ptr<pit::Entry>& pitEntry, time::millisec
   BOOST_ASSERT(pitEntry);
   BOOST_ASSERT(duration >= 0_ms);
 
-  pitEntry->expiryTimer.cancel();
-  pitEntry->expiryTimer = getScheduler().schedule(duration, [=] { onInterestFinalize(pitEntry); });
+  m_pitExpiryWheel.schedule(pitEntry->expiryTimer, duration);
 }
 
 void
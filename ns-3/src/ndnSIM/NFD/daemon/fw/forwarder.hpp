@@ -51,8 +51,12 @@ class Strategy;
 class Forwarder
 {
 public:
+  /** \param faceTable table of faces the forwarder receives packets from
+   *  \param nameTreeOptions options of the hashtable of the NameTree shared by all tables
+   */
   explicit
-  Forwarder(FaceTable& faceTable);
+  Forwarder(FaceTable& faceTable,
+            const name_tree::HashtableOptions& nameTreeOptions = name_tree::HashtableOptions(1024));
 
   VIRTUAL_WITH_TESTS
   ~Forwarder();
@@ -107,6 +111,55 @@ public: // forwarding entrypoints and tables
     this->onIncomingNack(ingress, nack);
   }
 
+  /** \brief an incoming packet and the face endpoint it was received from
+   */
+  template<typename Packet>
+  struct IncomingPacket
+  {
+    FaceEndpoint ingress;
+    shared_ptr<const Packet> packet;
+  };
+
+  using IncomingInterest = IncomingPacket<Interest>;
+  using IncomingData = IncomingPacket<Data>;
+
+  /** \brief start incoming Interest processing for a batch of Interests
+   *
+   *  Each pipeline stage runs across the whole batch before the next one starts: first the
+   *  scope control and Dead Nonce List checks, which also start loading the name tree buckets
+   *  of every Interest into the cache; then the PIT insertions; then the rest of the incoming
+   *  Interest pipeline. Interests of the same name are processed next to each other in their
+   *  arrival order, but Interests of different names may be reordered.
+   */
+  void
+  startProcessInterestBatch(const std::vector<IncomingInterest>& batch);
+
+  /** \brief start incoming Data processing for a batch of Data
+   *
+   *  The scope control runs across the whole batch first, and starts loading the name tree
+   *  buckets of every Data into the cache. Data of the same name are processed next to each
+   *  other in their arrival order, but Data of different names may be reordered.
+   */
+  void
+  startProcessDataBatch(const std::vector<IncomingData>& batch);
+
+  /** \brief set whether packets received by faces are processed in batches
+   *
+   *  When enabled, Interests and Data received from faces are queued, and the queue is passed
+   *  to startProcessInterestBatch() or startProcessDataBatch() from a scheduler event with zero
+   *  delay. Packets delivered at the same time are thus processed as one batch. A batch holds
+   *  packets of one type: receiving a packet of another type, a Nack, or removing a face
+   *  processes the queued packets first.
+   */
+  void
+  enableBatching(bool isEnabled);
+
+  bool
+  isBatchingEnabled() const
+  {
+    return m_isBatchingEnabled;
+  }
+
   /** \brief start new nexthop processing
    *  \param prefix the prefix of the FibEntry containing the new nexthop
    *  \param nextHop the new NextHop
@@ -250,6 +303,48 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   VIRTUAL_WITH_TESTS void
   onNewNextHop(const Name& prefix, const fib::NextHop& nextHop);
 
+private: // pipeline stages shared by single and batched processing
+  /** \brief receive an Interest and check its scope and the Dead Nonce List
+   *  \return whether the Interest should continue to PIT insertion
+   */
+  bool
+  acceptIncomingInterest(const FaceEndpoint& ingress, const Interest& interest);
+
+  /** \brief strip forwarding hint if necessary, then find or insert the PIT entry
+   */
+  shared_ptr<pit::Entry>
+  insertIncomingInterest(const FaceEndpoint& ingress, const Interest& interest);
+
+  /** \brief detect duplicate Nonce in PIT entry, then look up the Content Store if necessary
+   */
+  void
+  processIncomingInterest(const FaceEndpoint& ingress, const Interest& interest,
+                          const shared_ptr<pit::Entry>& pitEntry);
+
+  /** \brief receive a Data and check its scope
+   *  \return whether the Data should continue to PIT match
+   */
+  bool
+  acceptIncomingData(const FaceEndpoint& ingress, const Data& data);
+
+  /** \brief match Data against the PIT and satisfy the matched entries
+   */
+  void
+  processIncomingData(const FaceEndpoint& ingress, const Data& data);
+
+  /** \brief queue a packet received by a face while batching is enabled
+   */
+  void
+  enqueueInterest(const FaceEndpoint& ingress, const Interest& interest);
+
+  void
+  enqueueData(const FaceEndpoint& ingress, const Data& data);
+
+  /** \brief process all queued packets
+   */
+  void
+  flushBatch();
+
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   /** \brief set a new expiry timer (now + \p duration) on a PIT entry
    */
@@ -293,6 +388,14 @@ private:
   NetworkRegionTable m_networkRegionTable;
   shared_ptr<Face>   m_csFace;
 
+  /// expiry timers of PIT entries, driven by one scheduler event instead of one per entry
+  TimerWheel<pit::Entry> m_pitExpiryWheel;
+
+  bool m_isBatchingEnabled = false;
+  std::vector<IncomingInterest> m_pendingInterests;
+  std::vector<IncomingData> m_pendingData;
+  scheduler::ScopedEventId m_flushEvent;
+
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 };
@@ -29,6 +29,8 @@
 namespace nfd {
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const size_t TablesConfigSection::DEFAULT_DNL_CAPACITY = 65536;
+const double TablesConfigSection::DEFAULT_DNL_FALSE_POSITIVE_RATE = 0.001;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -99,6 +101,11 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     processNetworkRegionSection(*networkRegionSection, isDryRun);
   }
 
+  OptionalConfigSection deadNonceListSection = section.get_child_optional("dead_nonce_list");
+  if (deadNonceListSection) {
+    processDeadNonceListSection(*deadNonceListSection, isDryRun);
+  }
+
   if (isDryRun) {
     return;
   }
@@ -165,4 +172,40 @@ TablesConfigSection::processNetworkRegionSection(const ConfigSection& section, b
   }
 }
 
+void
+TablesConfigSection::processDeadNonceListSection(const ConfigSection& section, bool isDryRun)
+{
+  std::string mode = section.get<std::string>("mode", "exact");
+  if (mode != "exact" && mode != "bloom-filter") {
+    NDN_THROW(ConfigFile::Error("Unknown mode '" + mode + "' in section 'dead_nonce_list'"));
+  }
+
+  size_t capacity = DEFAULT_DNL_CAPACITY;
+  OptionalConfigSection capacityNode = section.get_child_optional("capacity");
+  if (capacityNode) {
+    capacity = ConfigFile::parseNumber<size_t>(*capacityNode, "capacity", "dead_nonce_list");
+    if (capacity == 0) {
+      NDN_THROW(ConfigFile::Error("Invalid value for option 'capacity' in section "
+                                  "'dead_nonce_list': must be positive"));
+    }
+  }
+
+  double falsePositiveRate = DEFAULT_DNL_FALSE_POSITIVE_RATE;
+  OptionalConfigSection falsePositiveRateNode = section.get_child_optional("false_positive_rate");
+  if (falsePositiveRateNode) {
+    falsePositiveRate = ConfigFile::parseNumber<double>(*falsePositiveRateNode,
+                                                        "false_positive_rate", "dead_nonce_list");
+    if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+      NDN_THROW(ConfigFile::Error("Invalid value for option 'false_positive_rate' in section "
+                                  "'dead_nonce_list': out of acceptable range (0, 1)"));
+    }
+  }
+
+  if (isDryRun || mode != "bloom-filter") {
+    return;
+  }
+
+  m_forwarder.getDeadNonceList().enableBloomFilter(capacity, falsePositiveRate);
+}
+
 } // namespace nfd
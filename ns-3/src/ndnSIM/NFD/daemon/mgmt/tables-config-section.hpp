@@ -91,8 +91,13 @@ private:
   void
   processNetworkRegionSection(const ConfigSection& section, bool isDryRun);
 
+  void
+  processDeadNonceListSection(const ConfigSection& section, bool isDryRun);
+
 private:
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const size_t DEFAULT_DNL_CAPACITY;
+  static const double DEFAULT_DNL_FALSE_POSITIVE_RATE;
 
   Forwarder& m_forwarder;
 
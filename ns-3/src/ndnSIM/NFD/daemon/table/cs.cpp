@@ -80,6 +80,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    m_hashIndex.emplace(PrefixView(data.getName()).hash(), it);
     m_policy->afterInsert(it);
   }
 }
@@ -104,7 +105,7 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    i = eraseEntry(i);
     ++nErased;
   }
   return nErased;
@@ -118,11 +119,26 @@ Cs::findImpl(const Interest& interest) const
   }
 
   const Name& prefix = interest.getName();
-  auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  const_iterator match = m_table.end();
+  if (!interest.getCanBePrefix()) {
+    match = findExactMatch(interest, prefix);
+    if (!prefix.empty() && prefix[-1].isImplicitSha256Digest()) {
+      auto digestMatch = findExactMatch(interest, PrefixView(prefix, prefix.size() - 1));
+      if (match == m_table.end() || (digestMatch != m_table.end() && digestMatch < match)) {
+        match = digestMatch;
+      }
+    }
+  }
+  else if (m_shouldMatchPrefix) {
+    auto range = findPrefixRange(prefix);
+    match = std::find_if(range.first, range.second,
+                         [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+    if (match == range.second) {
+      match = m_table.end();
+    }
+  }
 
-  if (match == range.second) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
     return m_table.end();
   }
@@ -131,6 +147,35 @@ Cs::findImpl(const Interest& interest) const
   return match;
 }
 
+Cs::const_iterator
+Cs::findExactMatch(const Interest& interest, const PrefixView& name) const
+{
+  const_iterator match = m_table.end();
+  auto range = m_hashIndex.equal_range(name.hash());
+  for (auto i = range.first; i != range.second; ++i) {
+    const_iterator entry = i->second;
+    // several Data packets may share a name; pick the first in Table order, as a Table search would
+    if ((match == m_table.end() || entry < match) &&
+        PrefixView(entry->getName()) == name && entry->canSatisfy(interest)) {
+      match = entry;
+    }
+  }
+  return match;
+}
+
+Cs::const_iterator
+Cs::eraseEntry(const_iterator it)
+{
+  auto range = m_hashIndex.equal_range(PrefixView(it->getName()).hash());
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second == it) {
+      m_hashIndex.erase(i);
+      break;
+    }
+  }
+  return m_table.erase(it);
+}
+
 void
 Cs::dump()
 {
@@ -155,7 +200,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { eraseEntry(it); });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
@@ -181,5 +226,15 @@ Cs::enableServe(bool shouldServe)
   NFD_LOG_INFO((shouldServe ? "Enabling" : "Disabling") << " Data serving");
 }
 
+void
+Cs::enablePrefixMatch(bool shouldMatchPrefix)
+{
+  if (m_shouldMatchPrefix == shouldMatchPrefix) {
+    return;
+  }
+  m_shouldMatchPrefix = shouldMatchPrefix;
+  NFD_LOG_INFO((shouldMatchPrefix ? "Enabling" : "Disabling") << " prefix match");
+}
+
 } // namespace cs
 } // namespace nfd
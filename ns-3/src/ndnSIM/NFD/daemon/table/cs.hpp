@@ -28,6 +28,8 @@
 
 #include "cs-policy.hpp"
 
+#include <unordered_map>
+
 namespace nfd {
 namespace cs {
 
@@ -39,6 +41,11 @@ namespace cs {
  *  Data packets are wrapped in Entry objects. Each Entry contains the Data packet itself,
  *  and a few additional attributes such as when the Data becomes non-fresh.
  *
+ *  Entries are also indexed by a hash of their Data name. An Interest without CanBePrefix can
+ *  only be satisfied by Data of the same name, or whose full name equals the Interest name,
+ *  so such lookups are answered from this index in constant time. The ordered Table is only
+ *  searched for Interests with CanBePrefix.
+ *
  *  The replacement policy is implemented in a subclass of \c Policy.
  */
 class Cs : noncopyable
@@ -157,6 +164,22 @@ public: // configuration
   void
   enableServe(bool shouldServe);
 
+  /** \brief get whether Interests with CanBePrefix can be served
+   */
+  bool
+  shouldMatchPrefix() const
+  {
+    return m_shouldMatchPrefix;
+  }
+
+  /** \brief set whether Interests with CanBePrefix can be served
+   *
+   *  When disabled, every lookup is answered from the hash index and lookups of Interests with
+   *  CanBePrefix miss. This suits deployments whose consumers always request exact names.
+   */
+  void
+  enablePrefixMatch(bool shouldMatchPrefix);
+
 public: // enumeration
   using const_iterator = Table::const_iterator;
 
@@ -182,6 +205,17 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief find the first entry that can satisfy \p interest among entries named \p name
+   */
+  const_iterator
+  findExactMatch(const Interest& interest, const PrefixView& name) const;
+
+  /** \brief erase an entry from both the Table and the hash index
+   *  \return iterator to the next entry in the Table
+   */
+  const_iterator
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -191,11 +225,13 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  std::unordered_multimap<size_t, const_iterator> m_hashIndex; ///< Data name hash => entry
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
   bool m_shouldServe = true; ///< if false, all lookups will miss
+  bool m_shouldMatchPrefix = true; ///< if false, lookups with CanBePrefix will miss
 };
 
 } // namespace cs
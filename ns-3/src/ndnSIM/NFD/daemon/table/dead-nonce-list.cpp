@@ -28,6 +28,9 @@
 #include "common/global.hpp"
 #include "common/logger.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace nfd {
 
 NFD_LOG_INIT(DeadNonceList);
@@ -67,6 +70,7 @@ DeadNonceList::~DeadNonceList()
 {
   m_markEvent.cancel();
   m_adjustCapacityEvent.cancel();
+  m_rotateEvent.cancel();
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
@@ -83,6 +87,9 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
+  if (this->isBloomFilterEnabled()) {
+    return m_nFilterEntries[0] + m_nFilterEntries[1];
+  }
   return m_queue.size() - this->countMarks();
 }
 
@@ -90,6 +97,9 @@ bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (this->isBloomFilterEnabled()) {
+    return m_filters[0].contains(entry) || m_filters[1].contains(entry);
+  }
   return m_ht.find(entry) != m_ht.end();
 }
 
@@ -97,6 +107,12 @@ void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (this->isBloomFilterEnabled()) {
+    m_filters[m_currentFilter].add(entry);
+    ++m_nFilterEntries[m_currentFilter];
+    return;
+  }
+
   m_queue.push_back(entry);
 
   this->evictEntries();
@@ -162,4 +178,85 @@ DeadNonceList::evictEntries()
   BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
+void
+DeadNonceList::enableBloomFilter(size_t capacity, double falsePositiveRate)
+{
+  if (capacity == 0) {
+    NDN_THROW(std::invalid_argument("capacity must be positive"));
+  }
+  if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+    NDN_THROW(std::invalid_argument("falsePositiveRate must be between 0 and 1"));
+  }
+
+  // a lookup queries both filters, so each of them gets about half of the false positive rate
+  double filterRate = 1.0 - std::sqrt(1.0 - falsePositiveRate);
+  double ln2 = std::log(2.0);
+  auto nBits = static_cast<size_t>(std::ceil(-static_cast<double>(capacity) * std::log(filterRate) /
+                                             (ln2 * ln2)));
+  auto nHashes = std::max<size_t>(1, static_cast<size_t>(std::round(ln2 * nBits / capacity)));
+  NFD_LOG_DEBUG("enableBloomFilter capacity=" << capacity << " fpr=" << falsePositiveRate
+                << " bits=" << nBits << " hashes=" << nHashes);
+
+  m_markEvent.cancel();
+  m_adjustCapacityEvent.cancel();
+  m_index.clear();
+  m_actualMarkCounts.clear();
+
+  m_filters.clear();
+  m_filters.reserve(2);
+  m_filters.emplace_back(nBits, nHashes);
+  m_filters.emplace_back(nBits, nHashes);
+  m_currentFilter = 0;
+  m_nFilterEntries.fill(0);
+  m_rotateEvent = getScheduler().schedule(m_lifetime, [this] { rotateFilters(); });
+}
+
+void
+DeadNonceList::rotateFilters()
+{
+  m_currentFilter ^= 1;
+  m_filters[m_currentFilter].clear();
+  m_nFilterEntries[m_currentFilter] = 0;
+
+  m_rotateEvent = getScheduler().schedule(m_lifetime, [this] { rotateFilters(); });
+}
+
+DeadNonceList::BloomFilter::BloomFilter(size_t nBits, size_t nHashes)
+  : m_bits((nBits + 63) / 64)
+  , m_nBits(m_bits.size() * 64)
+  , m_nHashes(nHashes)
+{
+}
+
+void
+DeadNonceList::BloomFilter::add(Entry entry)
+{
+  uint64_t h1 = entry & 0xFFFFFFFF;
+  uint64_t h2 = (entry >> 32) | 1;
+  for (size_t i = 0; i < m_nHashes; ++i) {
+    size_t bit = (h1 + i * h2) % m_nBits;
+    m_bits[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+}
+
+bool
+DeadNonceList::BloomFilter::contains(Entry entry) const
+{
+  uint64_t h1 = entry & 0xFFFFFFFF;
+  uint64_t h2 = (entry >> 32) | 1;
+  for (size_t i = 0; i < m_nHashes; ++i) {
+    size_t bit = (h1 + i * h2) % m_nBits;
+    if ((m_bits[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+DeadNonceList::BloomFilter::clear()
+{
+  std::fill(m_bits.begin(), m_bits.end(), 0);
+}
+
 } // namespace nfd
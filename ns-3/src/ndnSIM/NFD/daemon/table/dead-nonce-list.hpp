@@ -28,6 +28,8 @@
 
 #include "core/common.hpp"
 
+#include <array>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
@@ -50,6 +52,9 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Alternatively, the Dead Nonce List can be switched to a pair of Bloom filters of fixed size,
+ *  see enableBloomFilter().
  */
 class DeadNonceList : noncopyable
 {
@@ -91,6 +96,30 @@ public:
     return m_lifetime;
   }
 
+  /** \brief Switches to a rotating pair of Bloom filters
+   *  \param capacity expected number of Nonces added per lifetime
+   *  \param falsePositiveRate target probability that has() returns true for a name+nonce
+   *                           that was not added; must be in (0, 1)
+   *  \throw std::invalid_argument if capacity is zero or falsePositiveRate is out of range
+   *
+   *  Each filter records the Nonces added during one lifetime. At the end of every lifetime,
+   *  the older filter is cleared and starts recording, so that a Nonce is remembered for
+   *  between one and two lifetimes. Memory usage is fixed at about
+   *  2.9 * (log2(1 / falsePositiveRate) + 1) bits per Nonce of capacity;
+   *  the false positive rate rises if more Nonces are added.
+   *  Nonces recorded before the switch are dropped.
+   */
+  void
+  enableBloomFilter(size_t capacity, double falsePositiveRate);
+
+  /** \return whether Nonces are recorded in Bloom filters
+   */
+  bool
+  isBloomFilterEnabled() const
+  {
+    return !m_filters.empty();
+  }
+
 private: // Entry and Index
   typedef uint64_t Entry;
 
@@ -134,6 +163,36 @@ private: // actual lifetime estimation and capacity control
   void
   evictEntries();
 
+private: // Bloom filter mode
+  /** \brief A Bloom filter over Entry hashes
+   *
+   *  Bit positions are derived from the two halves of the hash by double hashing.
+   */
+  class BloomFilter
+  {
+  public:
+    BloomFilter(size_t nBits, size_t nHashes);
+
+    void
+    add(Entry entry);
+
+    bool
+    contains(Entry entry) const;
+
+    void
+    clear();
+
+  private:
+    std::vector<uint64_t> m_bits;
+    size_t m_nBits;
+    size_t m_nHashes;
+  };
+
+  /** \brief Clear the older filter and start recording into it
+   */
+  void
+  rotateFilters();
+
 public:
   /// Default entry lifetime
   static const time::nanoseconds DEFAULT_LIFETIME;
@@ -206,6 +265,13 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
 
   /// Maximum number of entries to evict at each operation if index is over capacity
   static const size_t EVICT_LIMIT;
+
+  // ---- Bloom filter mode
+
+  std::vector<BloomFilter> m_filters; ///< empty unless Bloom filter mode is enabled
+  size_t m_currentFilter = 0;
+  std::array<size_t, 2> m_nFilterEntries{};
+  scheduler::EventId m_rotateEvent;
 };
 
 } // namespace nfd
@@ -55,6 +55,11 @@ public:
   Entry*
   get(const Name& name);
 
+  /** \brief find or insert a Measurements entry for the name prefix viewed by \p prefix
+   */
+  Entry*
+  get(const PrefixView& prefix);
+
   /** \brief find or insert a Measurements entry for \p fibEntry->getPrefix()
    */
   Entry*
@@ -89,6 +94,11 @@ public:
   Entry*
   findExactMatch(const Name& name) const;
 
+  /** \brief perform an exact match on the name prefix viewed by \p prefix
+   */
+  Entry*
+  findExactMatch(const PrefixView& prefix) const;
+
   /** \brief extend lifetime of an entry
    *
    *  The entry will be kept until at least now()+lifetime.
@@ -124,6 +134,12 @@ MeasurementsAccessor::get(const Name& name)
   return this->filter(m_measurements.get(name));
 }
 
+inline Entry*
+MeasurementsAccessor::get(const PrefixView& prefix)
+{
+  return this->filter(m_measurements.get(prefix));
+}
+
 inline Entry*
 MeasurementsAccessor::get(const fib::Entry& fibEntry)
 {
@@ -162,6 +178,12 @@ MeasurementsAccessor::findExactMatch(const Name& name) const
   return this->filter(m_measurements.findExactMatch(name));
 }
 
+inline Entry*
+MeasurementsAccessor::findExactMatch(const PrefixView& prefix) const
+{
+  return this->filter(m_measurements.findExactMatch(prefix));
+}
+
 inline void
 MeasurementsAccessor::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
 {
@@ -62,6 +62,13 @@ Measurements::get(const Name& name)
   return this->get(nte);
 }
 
+Entry&
+Measurements::get(const PrefixView& prefix)
+{
+  name_tree::Entry& nte = m_nameTree.lookup(prefix.getName(), std::min(prefix.size(), getMaxDepth()));
+  return this->get(nte);
+}
+
 Entry&
 Measurements::get(const fib::Entry& fibEntry)
 {
@@ -123,6 +130,13 @@ Measurements::findExactMatch(const Name& name) const
   return nte == nullptr ? nullptr : nte->getMeasurementsEntry();
 }
 
+Entry*
+Measurements::findExactMatch(const PrefixView& prefix) const
+{
+  const name_tree::Entry* nte = m_nameTree.findExactMatch(prefix.getName(), prefix.size());
+  return nte == nullptr ? nullptr : nte->getMeasurementsEntry();
+}
+
 void
 Measurements::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
 {
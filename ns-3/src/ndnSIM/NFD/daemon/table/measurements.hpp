@@ -98,6 +98,13 @@ public:
   Entry&
   get(const Name& name);
 
+  /** \brief Find or insert an entry by the name prefix viewed by \p prefix
+   *
+   *  Equivalent to `get(prefix.toName())`, without building the Name unless a new entry is created.
+   */
+  Entry&
+  get(const PrefixView& prefix);
+
   /** \brief Equivalent to `get(fibEntry.getPrefix())`
    */
   Entry&
@@ -132,6 +139,11 @@ public:
   Entry*
   findExactMatch(const Name& name) const;
 
+  /** \brief Perform an exact match on the name prefix viewed by \p prefix
+   */
+  Entry*
+  findExactMatch(const PrefixView& prefix) const;
+
   static time::nanoseconds
   getInitialLifetime()
   {
@@ -36,9 +36,10 @@ class Hash32
 {
 public:
   static HashValue
-  compute(const void* buffer, size_t length)
+  compute(const void* buffer, size_t length, HashValue seed)
   {
-    return static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
+    HashValue h = static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
+    return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2));
   }
 };
 
@@ -46,13 +47,13 @@ class Hash64
 {
 public:
   static HashValue
-  compute(const void* buffer, size_t length)
+  compute(const void* buffer, size_t length, HashValue seed)
   {
-    return static_cast<HashValue>(CityHash64(reinterpret_cast<const char*>(buffer), length));
+    return static_cast<HashValue>(CityHash64WithSeed(reinterpret_cast<const char*>(buffer), length, seed));
   }
 };
 
-/** \brief a type with compute static method to compute hash value from a raw buffer
+/** \brief a type with compute static method to compute hash value from a raw buffer and a seed
  */
 using HashFunc = std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type;
 
@@ -64,7 +65,7 @@ computeHash(const Name& name, size_t prefixLen)
   HashValue h = 0;
   for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
     const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.wire(), comp.size());
+    h = HashFunc::compute(comp.wire(), comp.size(), h);
   }
   return h;
 }
@@ -83,12 +84,75 @@ computeHashes(const Name& name, size_t prefixLen)
 
   for (size_t i = 0; i < last; ++i) {
     const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.wire(), comp.size());
+    h = HashFunc::compute(comp.wire(), comp.size(), h);
     seq.push_back(h);
   }
   return seq;
 }
 
+/** \brief caches the hash sequence of a packet name on the packet
+ */
+class HashSequenceTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1100;
+  }
+
+  explicit
+  HashSequenceTag(const Name& name)
+    : hashes(computeHashes(name))
+    , m_nameWire(name.wireEncode())
+  {
+  }
+
+  /** \return whether the sequence was computed for \p name
+   *
+   *  Wire buffers are immutable and shared by copies of a Name, so a name encoded at the same
+   *  address is the same name. The tag holds the encoding, so that its address cannot be reused
+   *  by another name. A name that is set again is re-encoded elsewhere and no longer matches.
+   */
+  bool
+  isFor(const Name& name) const
+  {
+    const Block& wire = name.wireEncode();
+    return wire.wire() == m_nameWire.wire() && wire.size() == m_nameWire.size();
+  }
+
+public:
+  const HashSequence hashes;
+
+private:
+  const Block m_nameWire;
+};
+
+template<typename Packet>
+static const HashSequence&
+getCachedHashes(const Packet& packet)
+{
+  auto tag = packet.template getTag<HashSequenceTag>();
+  if (tag == nullptr || !tag->isFor(packet.getName())) {
+    tag = make_shared<HashSequenceTag>(packet.getName());
+    packet.setTag(tag);
+  }
+  // the packet keeps the tag alive
+  return tag->hashes;
+}
+
+const HashSequence&
+getHashes(const Interest& interest)
+{
+  return getCachedHashes(interest);
+}
+
+const HashSequence&
+getHashes(const Data& data)
+{
+  return getCachedHashes(data);
+}
+
 Node::Node(HashValue h, const Name& name)
   : hash(h)
   , prev(nullptr)
@@ -109,12 +173,35 @@ getNode(const Entry& entry)
   return entry.m_node;
 }
 
+std::ostream&
+operator<<(std::ostream& os, HashtableBackend backend)
+{
+  switch (backend) {
+    case HashtableBackend::CHAINED:
+      return os << "chained";
+    case HashtableBackend::OPEN_ADDRESSING:
+      return os << "open-addressing";
+  }
+  return os << static_cast<int>(backend);
+}
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
 {
 }
 
+/** \brief number of old groups moved into the new table on each insertion or deletion
+ *
+ *  A resize to twice the size starts at half load, so the new table is complete well before
+ *  it reaches its own expand threshold.
+ */
+static const size_t MIGRATION_STEP = 4;
+
+constexpr size_t Hashtable::Group::SIZE;
+constexpr uint8_t Hashtable::Group::EMPTY;
+constexpr uint8_t Hashtable::Group::DELETED;
+
 Hashtable::Hashtable(const Options& options)
   : m_options(options)
   , m_size(0)
@@ -129,12 +216,27 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+    // probing needs at least one free slot, and is unbearably long without many of them
+    BOOST_ASSERT(m_options.expandLoadFactor < 1.0);
+    m_groups.resize((options.initialSize + Group::SIZE - 1) / Group::SIZE, Group{});
+  }
+  else {
+    m_buckets.resize(options.initialSize);
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
+  if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+    foreachNode(m_nodeList, [] (Node* node) {
+      node->prev = node->next = nullptr;
+      delete node;
+    });
+    return;
+  }
+
   for (size_t i = 0; i < m_buckets.size(); ++i) {
     foreachNode(m_buckets[i], [] (Node* node) {
       node->prev = node->next = nullptr;
@@ -180,6 +282,10 @@ Hashtable::detach(size_t bucket, Node* node)
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+    return this->findOrInsertOpen(name, prefixLen, h, allowInsert);
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -233,6 +339,11 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
+  if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+    this->eraseOpen(node);
+    return;
+  }
+
   size_t bucket = this->computeBucketIndex(node->hash);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
@@ -247,6 +358,37 @@ Hashtable::erase(Node* node)
   }
 }
 
+const Node*
+Hashtable::getFirstNode() const
+{
+  if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+    return m_nodeList;
+  }
+
+  for (const Node* head : m_buckets) {
+    if (head != nullptr) {
+      return head;
+    }
+  }
+  return nullptr;
+}
+
+const Node*
+Hashtable::getNextNode(const Node* node) const
+{
+  BOOST_ASSERT(node != nullptr);
+  if (node->next != nullptr || m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+    return node->next;
+  }
+
+  for (size_t bucket = this->computeBucketIndex(node->hash) + 1; bucket < m_buckets.size(); ++bucket) {
+    if (m_buckets[bucket] != nullptr) {
+      return m_buckets[bucket];
+    }
+  }
+  return nullptr;
+}
+
 void
 Hashtable::computeThresholds()
 {
@@ -277,5 +419,214 @@ Hashtable::resize(size_t newNBuckets)
   this->computeThresholds();
 }
 
+const Node*
+Hashtable::findInGroups(const Groups& groups, const Name& name, size_t prefixLen, HashValue h)
+{
+  uint8_t fingerprint = computeFingerprint(h);
+  size_t index = computeGroupIndex(groups, h);
+
+  for (size_t nProbes = 0; nProbes < groups.size(); ++nProbes) {
+    const Group& group = groups[index];
+    bool hasEmpty = false;
+    for (size_t slot = 0; slot < Group::SIZE; ++slot) {
+      if (group.ctrl[slot] == fingerprint) {
+        const Node* node = group.nodes[slot];
+        if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+          return node;
+        }
+      }
+      hasEmpty = hasEmpty || group.ctrl[slot] == Group::EMPTY;
+    }
+    if (hasEmpty) {
+      // an insertion would have stopped here
+      return nullptr;
+    }
+    index = index + 1 == groups.size() ? 0 : index + 1;
+  }
+  return nullptr;
+}
+
+bool
+Hashtable::insertIntoGroups(Groups& groups, Node* node)
+{
+  size_t index = computeGroupIndex(groups, node->hash);
+
+  for (size_t nProbes = 0; nProbes < groups.size(); ++nProbes) {
+    Group& group = groups[index];
+    for (size_t slot = 0; slot < Group::SIZE; ++slot) {
+      if (group.ctrl[slot] == Group::EMPTY || group.ctrl[slot] == Group::DELETED) {
+        bool isReused = group.ctrl[slot] == Group::DELETED;
+        group.ctrl[slot] = computeFingerprint(node->hash);
+        group.nodes[slot] = node;
+        return isReused;
+      }
+    }
+    index = index + 1 == groups.size() ? 0 : index + 1;
+  }
+
+  // thresholds keep the load factor below 1
+  BOOST_ASSERT(false);
+  return false;
+}
+
+std::pair<bool, bool>
+Hashtable::eraseFromGroups(Groups& groups, const Node* node)
+{
+  if (groups.empty()) {
+    return {false, false};
+  }
+
+  uint8_t fingerprint = computeFingerprint(node->hash);
+  size_t index = computeGroupIndex(groups, node->hash);
+
+  for (size_t nProbes = 0; nProbes < groups.size(); ++nProbes) {
+    Group& group = groups[index];
+    bool hasEmpty = false;
+    size_t found = Group::SIZE;
+    for (size_t slot = 0; slot < Group::SIZE; ++slot) {
+      if (group.ctrl[slot] == fingerprint && group.nodes[slot] == node) {
+        found = slot;
+      }
+      hasEmpty = hasEmpty || group.ctrl[slot] == Group::EMPTY;
+    }
+
+    if (found < Group::SIZE) {
+      // if the group has a free slot, no probe sequence has continued past it,
+      // so the slot can be made EMPTY rather than DELETED
+      group.ctrl[found] = hasEmpty ? Group::EMPTY : Group::DELETED;
+      group.nodes[found] = nullptr;
+      return {true, !hasEmpty};
+    }
+    if (hasEmpty) {
+      return {false, false};
+    }
+    index = index + 1 == groups.size() ? 0 : index + 1;
+  }
+  return {false, false};
+}
+
+std::pair<const Node*, bool>
+Hashtable::findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  const Node* found = findInGroups(m_groups, name, prefixLen, h);
+  if (found == nullptr && this->isResizing()) {
+    found = findInGroups(m_oldGroups, name, prefixLen, h);
+  }
+  if (found != nullptr) {
+    NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {found, false};
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {nullptr, false};
+  }
+
+  Node* node = new Node(h, name.getPrefix(prefixLen));
+  node->next = m_nodeList;
+  if (m_nodeList != nullptr) {
+    m_nodeList->prev = node;
+  }
+  m_nodeList = node;
+
+  if (insertIntoGroups(m_groups, node)) {
+    --m_nDeletedSlots;
+  }
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h);
+  ++m_size;
+
+  this->migrate(MIGRATION_STEP);
+  if (m_size + m_nDeletedSlots > m_expandThreshold) {
+    // grow if the table is really full; otherwise, rehash into the same size to drop DELETED slots
+    this->resizeOpen(m_size > m_expandThreshold ?
+                     static_cast<size_t>(m_options.expandFactor * this->getNBuckets()) :
+                     this->getNBuckets());
+  }
+
+  return {node, true};
+}
+
+void
+Hashtable::eraseOpen(Node* node)
+{
+  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash);
+
+  bool isFound = false;
+  bool isDeleted = false;
+  std::tie(isFound, isDeleted) = eraseFromGroups(m_groups, node);
+  if (isFound) {
+    m_nDeletedSlots += isDeleted;
+  }
+  else {
+    std::tie(isFound, isDeleted) = eraseFromGroups(m_oldGroups, node);
+  }
+  BOOST_ASSERT(isFound);
+
+  (node->prev == nullptr ? m_nodeList : node->prev->next) = node->next;
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  }
+  node->prev = node->next = nullptr;
+  delete node;
+  --m_size;
+
+  this->migrate(MIGRATION_STEP);
+  if (m_size < m_shrinkThreshold) {
+    size_t newNBuckets = std::max(m_options.minSize,
+      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
+    if (newNBuckets <= this->getNBuckets() - Group::SIZE) {
+      this->resizeOpen(newNBuckets);
+    }
+  }
+}
+
+void
+Hashtable::resizeOpen(size_t newNBuckets)
+{
+  size_t nGroups = (newNBuckets + Group::SIZE - 1) / Group::SIZE;
+  if (nGroups == m_groups.size() && m_nDeletedSlots == 0) {
+    return;
+  }
+  NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << nGroups * Group::SIZE);
+
+  // a resize that starts before the previous one has finished completes the previous one first
+  this->migrate(m_oldGroups.size());
+
+  m_oldGroups.swap(m_groups);
+  m_groups.assign(nGroups, Group{});
+  m_nMigratedGroups = 0;
+  m_nDeletedSlots = 0;
+  this->computeThresholds();
+}
+
+void
+Hashtable::migrate(size_t nGroups)
+{
+  if (!this->isResizing()) {
+    return;
+  }
+
+  size_t end = std::min(m_nMigratedGroups + nGroups, m_oldGroups.size());
+  for (; m_nMigratedGroups < end; ++m_nMigratedGroups) {
+    Group& group = m_oldGroups[m_nMigratedGroups];
+    for (size_t slot = 0; slot < Group::SIZE; ++slot) {
+      if (group.ctrl[slot] != Group::EMPTY && group.ctrl[slot] != Group::DELETED) {
+        if (insertIntoGroups(m_groups, group.nodes[slot])) {
+          --m_nDeletedSlots;
+        }
+        // keep probing through the slot for nodes that have not been moved yet
+        group.ctrl[slot] = Group::DELETED;
+        group.nodes[slot] = nullptr;
+      }
+    }
+  }
+
+  if (m_nMigratedGroups == m_oldGroups.size()) {
+    NFD_LOG_DEBUG("resize complete size=" << this->getNBuckets());
+    Groups().swap(m_oldGroups);
+    m_nMigratedGroups = 0;
+  }
+}
+
 } // namespace name_tree
 } // namespace nfd
@@ -28,6 +28,8 @@
 
 #include "name-tree-entry.hpp"
 
+#include <boost/align/aligned_allocator.hpp>
+
 namespace nfd {
 namespace name_tree {
 
@@ -43,6 +45,9 @@ using HashValue = size_t;
 using HashSequence = std::vector<HashValue>;
 
 /** \brief computes hash value of \p name.getPrefix(prefixLen)
+ *
+ *  Each component is hashed with the hash of the preceding prefix as seed, so the value
+ *  depends on the order of the components.
  */
 HashValue
 computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
@@ -53,10 +58,26 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief returns the hash sequence of \p interest.getName()
+ *
+ *  The sequence is computed on first use and cached on the packet, so that the PIT, FIB,
+ *  Measurements and StrategyChoice lookups made for the same packet share one computation.
+ *  The cached sequence is recomputed if the name has been set again since.
+ */
+const HashSequence&
+getHashes(const Interest& interest);
+
+/** \brief returns the hash sequence of \p data.getName()
+ *  \sa getHashes(const Interest&)
+ */
+const HashSequence&
+getHashes(const Data& data);
+
 /** \brief a hashtable node
  *
- *  Zero or more nodes can be added to a hashtable bucket. They are organized as
- *  a doubly linked list through prev and next pointers.
+ *  With the chained backend, zero or more nodes can be added to a hashtable bucket. They are
+ *  organized as a doubly linked list through prev and next pointers. With the open addressing
+ *  backend, prev and next link all nodes of the hashtable in enumeration order.
  */
 class Node : noncopyable
 {
@@ -101,6 +122,21 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief storage layout of a Hashtable
+ */
+enum class HashtableBackend {
+  /** \brief buckets of doubly linked nodes, all rehashed at once when the table is resized
+   */
+  CHAINED,
+  /** \brief cache-line-sized groups of hash fingerprints and node pointers, probed linearly;
+   *         a resize moves a few groups into the new table on each insertion or deletion
+   */
+  OPEN_ADDRESSING,
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashtableBackend backend);
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -114,7 +150,14 @@ public:
   HashtableOptions(size_t size = 16);
 
 public:
+  /** \brief storage layout
+   */
+  HashtableBackend backend = HashtableBackend::CHAINED;
+
   /** \brief initial number of buckets
+   *
+   *  With the open addressing backend, a bucket is a slot holding a single node,
+   *  and the number of slots is rounded up to a whole number of groups.
    */
   size_t initialSize;
 
@@ -143,8 +186,17 @@ public:
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
  *  The number of buckets is adjusted according to how many nodes are stored.
+ *
+ *  With the chained backend, hash collision is resolved through a doubly linked list in each
+ *  bucket, and all nodes are relinked when the number of buckets changes.
+ *
+ *  With the open addressing backend, each bucket is a slot in a cache-line-sized group, which
+ *  keeps a one-byte fingerprint of the hash of each node next to the node pointers, so that
+ *  most mismatching slots are skipped without touching the node. Collisions continue into the
+ *  following groups. When the number of slots changes, the nodes are moved into the new table
+ *  a few groups at a time by subsequent insertions and deletions; until then, lookups search
+ *  both tables.
  */
 class Hashtable
 {
@@ -171,10 +223,14 @@ public:
   size_t
   getNBuckets() const
   {
+    if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+      return m_groups.size() * Group::SIZE;
+    }
     return m_buckets.size();
   }
 
   /** \return bucket index for hash value h
+   *  \pre the backend is HashtableBackend::CHAINED
    */
   size_t
   computeBucketIndex(HashValue h) const
@@ -184,14 +240,34 @@ public:
 
   /** \return i-th bucket
    *  \pre bucket < getNBuckets()
+   *  \pre the backend is HashtableBackend::CHAINED
    */
   const Node*
   getBucket(size_t bucket) const
   {
+    BOOST_ASSERT(m_options.backend == HashtableBackend::CHAINED);
     BOOST_ASSERT(bucket < this->getNBuckets());
     return m_buckets[bucket]; // don't use m_bucket.at() for better performance
   }
 
+  /** \return whether nodes are being moved into a resized table
+   */
+  bool
+  isResizing() const
+  {
+    return !m_oldGroups.empty();
+  }
+
+  /** \return first node in enumeration order, or nullptr if the hashtable is empty
+   */
+  const Node*
+  getFirstNode() const;
+
+  /** \return node after \p node in enumeration order, or nullptr if \p node is the last one
+   */
+  const Node*
+  getNextNode(const Node* node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -205,6 +281,26 @@ public:
   const Node*
   find(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
 
+  /** \brief hint the processor to load the bucket for hash value \p h into the cache
+   *
+   *  This has no effect on the content of the hashtable. Issuing it for several packets
+   *  before looking any of them up overlaps the cache misses of their lookups.
+   */
+  void
+  prefetch(HashValue h) const
+  {
+#if defined(__GNUC__)
+    if (m_options.backend == HashtableBackend::OPEN_ADDRESSING) {
+      if (!m_groups.empty()) {
+        __builtin_prefetch(&m_groups[computeGroupIndex(m_groups, h)]);
+      }
+    }
+    else {
+      __builtin_prefetch(&m_buckets[this->computeBucketIndex(h)]);
+    }
+#endif
+  }
+
   /** \brief find or insert node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    *  \pre hashes == computeHashes(name)
@@ -238,12 +334,78 @@ private:
   void
   resize(size_t newNBuckets);
 
+private: // open addressing backend
+  /** \brief a cache-line-sized group of slots
+   *
+   *  The control byte of a slot is EMPTY, DELETED, or the fingerprint of the hash of its node.
+   */
+  struct Group
+  {
+    static constexpr size_t SIZE = 7;
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t DELETED = 1;
+
+    uint8_t ctrl[SIZE];
+    Node* nodes[SIZE];
+  };
+
+  using Groups = std::vector<Group, boost::alignment::aligned_allocator<Group, 64>>;
+
+  static uint8_t
+  computeFingerprint(HashValue h)
+  {
+    return static_cast<uint8_t>(0x80 | (h & 0x7F));
+  }
+
+  static size_t
+  computeGroupIndex(const Groups& groups, HashValue h)
+  {
+    return (h >> 7) % groups.size();
+  }
+
+  static const Node*
+  findInGroups(const Groups& groups, const Name& name, size_t prefixLen, HashValue h);
+
+  /** \brief place a node into the first free slot of its probe sequence
+   *  \return whether a DELETED slot was reused
+   */
+  static bool
+  insertIntoGroups(Groups& groups, Node* node);
+
+  /** \brief free the slot of \p node, if it is in \p groups
+   *  \return whether the node was found; whether its slot was marked DELETED
+   */
+  static std::pair<bool, bool>
+  eraseFromGroups(Groups& groups, const Node* node);
+
+  std::pair<const Node*, bool>
+  findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  void
+  eraseOpen(Node* node);
+
+  /** \brief start moving nodes into a table with at least \p newNBuckets slots
+   */
+  void
+  resizeOpen(size_t newNBuckets);
+
+  /** \brief move the nodes of up to \p nGroups groups of the old table into the new table
+   */
+  void
+  migrate(size_t nGroups);
+
 private:
   std::vector<Node*> m_buckets;
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+
+  Groups m_groups;
+  Groups m_oldGroups; ///< groups being moved into m_groups during a resize
+  size_t m_nMigratedGroups = 0; ///< number of groups of m_oldGroups already moved
+  size_t m_nDeletedSlots = 0; ///< number of DELETED slots in m_groups
+  Node* m_nodeList = nullptr; ///< all nodes, in enumeration order
 };
 
 } // namespace name_tree
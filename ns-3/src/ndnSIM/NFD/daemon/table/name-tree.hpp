@@ -39,6 +39,9 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  explicit
+  NameTree(const HashtableOptions& options);
+
 public: // information
   /** \brief Maximum depth of the name tree
    *
@@ -92,6 +95,12 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, using precomputed hashes of \p name
+   *  \pre hashes == computeHashes(name, n) for some n >= prefixLen
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -148,6 +157,12 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief Equivalent to `findExactMatch(name, prefixLen)`, using precomputed hashes of \p name
+   *  \pre hashes == computeHashes(name, n) for some n >= min(prefixLen, name.size())
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief Longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -157,6 +172,14 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findLongestPrefixMatch(name, entrySelector)`,
+   *         using precomputed hashes of \p name
+   *  \pre hashes == computeHashes(name)
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +236,26 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findAllMatches(name, entrySelector)`, using precomputed hashes of \p name
+   *  \pre hashes == computeHashes(name)
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
+  /** \brief hint the processor to load the hashtable buckets of every prefix of \p name
+   *  \pre hashes == computeHashes(name)
+   *  \sa Hashtable::prefetch
+   */
+  void
+  prefetch(const HashSequence& hashes) const
+  {
+    size_t nPrefixes = std::min(hashes.size(), getMaxDepth() + 1);
+    for (size_t i = 0; i < nPrefixes; ++i) {
+      m_ht.prefetch(hashes[i]);
+    }
+  }
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -28,8 +28,9 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
+#include "common/timer-wheel.hpp"
 
-#include <list>
+#include <boost/container/small_vector.hpp>
 
 namespace nfd {
 
@@ -40,12 +41,16 @@ class Entry;
 namespace pit {
 
 /** \brief An unordered collection of in-records
+ *
+ *  Most entries have one or two downstreams, whose records are stored inline in the entry.
+ *  Inserting or deleting a record invalidates iterators to other records.
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef boost::container::small_vector<InRecord, 2> InRecordCollection;
 
 /** \brief An unordered collection of out-records
+ *  \sa InRecordCollection
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, 2> OutRecordCollection;
 
 /** \brief An Interest table entry
  *
@@ -55,7 +60,7 @@ typedef std::list<OutRecord> OutRecordCollection;
  *  In addition, the entry, in-records, and out-records are subclasses of StrategyInfoHost,
  *  which allows forwarding strategy to store arbitrary information on them.
  */
-class Entry : public StrategyInfoHost, noncopyable
+class Entry : public StrategyInfoHost, public std::enable_shared_from_this<Entry>, noncopyable
 {
 public:
   explicit
@@ -220,7 +225,7 @@ public:
    *
    *  This timer is used in forwarding pipelines to delete the entry
    */
-  scheduler::EventId expiryTimer;
+  TimerWheel<Entry>::Timer expiryTimer{*this};
 
   /** \brief Indicates whether this PIT entry is satisfied
    */
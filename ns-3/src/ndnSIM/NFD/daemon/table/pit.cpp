@@ -36,6 +36,7 @@ nteHasPitEntries(const name_tree::Entry& nte)
 
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
+  , m_entrySlab(make_shared<Slab>())
 {
 }
 
@@ -49,12 +50,13 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   nteDepth = std::min(nteDepth, NameTree::getMaxDepth());
 
   // ensure NameTree entry exists
+  const name_tree::HashSequence& hashes = name_tree::getHashes(interest);
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = &m_nameTree.lookup(name, nteDepth, hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = m_nameTree.findExactMatch(name, nteDepth, hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -76,7 +78,7 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  auto entry = std::allocate_shared<Entry>(SlabAllocator<Entry>(m_entrySlab), interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -85,7 +87,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), name_tree::getHashes(data),
+                                             &nteHasPitEntries);
 
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
@@ -28,6 +28,7 @@
 
 #include "pit-entry.hpp"
 #include "pit-iterator.hpp"
+#include "common/slab-allocator.hpp"
 
 namespace nfd {
 namespace pit {
@@ -43,6 +44,9 @@ namespace pit {
 using DataMatchResult = std::vector<shared_ptr<Entry>>;
 
 /** \brief Represents the Interest Table
+ *
+ *  Entries are allocated from a Slab owned by the table, so that inserting and erasing
+ *  entries recycles memory rather than going through the system allocator.
  */
 class Pit : noncopyable
 {
@@ -136,6 +140,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  shared_ptr<Slab> m_entrySlab; ///< storage of entries, together with their shared_ptr control blocks
 };
 
 } // namespace pit
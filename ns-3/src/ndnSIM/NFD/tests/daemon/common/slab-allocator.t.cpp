@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/slab-allocator.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestSlabAllocator)
+
+BOOST_AUTO_TEST_CASE(Recycle)
+{
+  Slab slab(4);
+  BOOST_CHECK_EQUAL(slab.getChunkSize(), 0);
+
+  std::vector<void*> chunks;
+  for (int i = 0; i < 5; ++i) {
+    chunks.push_back(slab.allocate(24));
+  }
+  BOOST_CHECK_GE(slab.getChunkSize(), 24);
+  BOOST_CHECK_EQUAL(slab.size(), 5);
+  BOOST_CHECK_EQUAL(slab.capacity(), 8);
+  BOOST_CHECK_EQUAL(std::set<void*>(chunks.begin(), chunks.end()).size(), 5);
+
+  void* recycled = chunks.back();
+  slab.deallocate(recycled, 24);
+  BOOST_CHECK_EQUAL(slab.size(), 4);
+  BOOST_CHECK_EQUAL(slab.allocate(24), recycled);
+  BOOST_CHECK_EQUAL(slab.capacity(), 8);
+
+  // other sizes do not come from the slab
+  void* other = slab.allocate(1000);
+  BOOST_CHECK_EQUAL(slab.size(), 5);
+  slab.deallocate(other, 1000);
+
+  for (void* chunk : chunks) {
+    slab.deallocate(chunk, 24);
+  }
+  BOOST_CHECK_EQUAL(slab.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AllocateShared)
+{
+  auto slab = make_shared<Slab>();
+  weak_ptr<Slab> weakSlab = slab;
+
+  auto p1 = std::allocate_shared<std::string>(SlabAllocator<std::string>(slab), "p1");
+  auto p2 = std::allocate_shared<std::string>(SlabAllocator<std::string>(slab), "p2");
+  BOOST_CHECK_EQUAL(slab->size(), 2);
+
+  p1.reset();
+  BOOST_CHECK_EQUAL(slab->size(), 1);
+
+  // objects keep the slab alive after its owner releases it
+  slab.reset();
+  BOOST_CHECK(!weakSlab.expired());
+  BOOST_CHECK_EQUAL(*p2, "p2");
+  p2.reset();
+  BOOST_CHECK(weakSlab.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSlabAllocator
+
+} // namespace tests
+} // namespace nfd
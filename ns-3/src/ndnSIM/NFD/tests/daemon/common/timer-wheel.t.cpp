@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/timer-wheel.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace tests {
+
+class TimerWheelFixture : public GlobalIoTimeFixture
+{
+protected:
+  struct Item
+  {
+    Item()
+      : timer(*this)
+    {
+    }
+
+    TimerWheel<Item>::Timer timer;
+    std::vector<time::steady_clock::TimePoint> expiries;
+  };
+
+  TimerWheelFixture()
+    : wheel([] (Item& item) { item.expiries.push_back(time::steady_clock::now()); })
+    , start(time::steady_clock::now())
+  {
+  }
+
+protected:
+  TimerWheel<Item> wheel;
+  time::steady_clock::TimePoint start;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  Item a, b, c;
+  wheel.schedule(a.timer, 10_ms);
+  wheel.schedule(b.timer, 300_ms);
+  wheel.schedule(c.timer, 70_s); // filed two levels up
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+  BOOST_CHECK(a.timer.isScheduled());
+
+  advanceClocks(1_ms, 9);
+  BOOST_CHECK_EQUAL(a.expiries.size(), 0);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(a.expiries.size(), 1);
+  BOOST_CHECK(a.expiries[0] == start + 10_ms);
+  BOOST_CHECK(!a.timer.isScheduled());
+
+  advanceClocks(1_ms, 300);
+  BOOST_REQUIRE_EQUAL(b.expiries.size(), 1);
+  BOOST_CHECK(b.expiries[0] == start + 300_ms);
+
+  advanceClocks(100_ms, 700);
+  BOOST_CHECK_EQUAL(c.expiries.size(), 1);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Resolution)
+{
+  advanceClocks(300_us);
+
+  // a deadline between two ticks expires at the later tick, never early
+  Item a;
+  wheel.schedule(a.timer, 5_ms);
+  advanceClocks(100_us, 50);
+  BOOST_CHECK_EQUAL(a.expiries.size(), 0);
+  advanceClocks(100_us, 7);
+  BOOST_REQUIRE_EQUAL(a.expiries.size(), 1);
+  BOOST_CHECK(a.expiries[0] >= start + 5300_us);
+  BOOST_CHECK(a.expiries[0] <= start + 5300_us + wheel.getResolution());
+}
+
+BOOST_AUTO_TEST_CASE(CancelAndReschedule)
+{
+  Item a, b;
+  wheel.schedule(a.timer, 10_ms);
+  wheel.schedule(b.timer, 10_ms);
+  a.timer.cancel();
+  BOOST_CHECK(!a.timer.isScheduled());
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  wheel.schedule(b.timer, 20_ms);
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  advanceClocks(1_ms, 15);
+  BOOST_CHECK_EQUAL(a.expiries.size(), 0);
+  BOOST_CHECK_EQUAL(b.expiries.size(), 0);
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK_EQUAL(b.expiries.size(), 1);
+
+  {
+    Item c;
+    wheel.schedule(c.timer, 10_ms);
+  } // destructing the owner cancels its timer
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  advanceClocks(1_ms, 20);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroDelay)
+{
+  advanceClocks(300_us);
+
+  Item a, b;
+  wheel.schedule(a.timer, 0_ms);
+  wheel.schedule(b.timer, 0_ms);
+  advanceClocks(1_ns);
+  BOOST_REQUIRE_EQUAL(a.expiries.size(), 1);
+  BOOST_CHECK(a.expiries[0] == start + 300_us);
+  BOOST_REQUIRE_EQUAL(b.expiries.size(), 1);
+  BOOST_CHECK(b.expiries[0] == start + 300_us);
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleFromCallback)
+{
+  Item a;
+  int nExpired = 0;
+  TimerWheel<Item> periodic([&] (Item& item) {
+    if (++nExpired < 5) {
+      periodic.schedule(item.timer, 7_ms);
+    }
+  });
+  periodic.schedule(a.timer, 7_ms);
+
+  advanceClocks(1_ms, 100);
+  BOOST_CHECK_EQUAL(nExpired, 5);
+  BOOST_CHECK_EQUAL(periodic.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTimerWheel
+
+} // namespace tests
+} // namespace nfd
@@ -458,6 +458,60 @@ BOOST_AUTO_TEST_CASE(OverFragCount)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(OverPartialPacketLimit)
+{
+  LpReassembler::Options options;
+  options.nMaxPartialPackets = 2;
+  reassembler.setOptions(options);
+
+  ndn::Buffer data1Buffer(data, 5);
+  ndn::Buffer data2Buffer(data + 5, 5);
+
+  auto makeFragment = [] (const ndn::Buffer& buffer, uint64_t fragIndex, lp::Sequence sequence) {
+    lp::Packet packet;
+    packet.add<lp::FragmentField>(std::make_pair(buffer.begin(), buffer.end()));
+    packet.add<lp::FragIndexField>(fragIndex);
+    packet.add<lp::FragCountField>(2);
+    packet.add<lp::SequenceField>(sequence);
+    return packet;
+  };
+
+  bool isComplete = false;
+  Block netPacket;
+
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data1Buffer, 0, 1000));
+  BOOST_REQUIRE(!isComplete);
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data1Buffer, 0, 2000));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+
+  // a third partial packet is dropped
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data1Buffer, 0, 3000));
+  BOOST_REQUIRE(!isComplete);
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data2Buffer, 1, 3001));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+
+  // completing a partial packet makes room for another one
+  std::tie(isComplete, netPacket, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data2Buffer, 1, 1001));
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data1Buffer, 0, 3000));
+  BOOST_REQUIRE(!isComplete);
+  std::tie(isComplete, netPacket, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(data2Buffer, 1, 3001));
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // MultiFragment
 
 BOOST_AUTO_TEST_SUITE(MultipleRemoteEndpoints)
@@ -557,6 +557,79 @@ BOOST_AUTO_TEST_CASE(PitLeak) // Bug 3484
   BOOST_CHECK_EQUAL(pit.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(InterestBatch)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entry, *face3, 0);
+
+  auto interestLooped = makeInterest("/A/0", false, nullopt, 6319);
+  forwarder.getDeadNonceList().add(interestLooped->getName(), interestLooped->getNonce());
+
+  std::vector<Forwarder::IncomingInterest> batch;
+  batch.push_back({FaceEndpoint(*face1, 0), makeInterest("/A/1", false, nullopt, 3101)});
+  batch.push_back({FaceEndpoint(*face1, 0), makeInterest("/A/2", false, nullopt, 3102)});
+  batch.push_back({FaceEndpoint(*face2, 0), makeInterest("/A/1", false, nullopt, 3103)});
+  batch.push_back({FaceEndpoint(*face2, 0), interestLooped});
+  forwarder.startProcessInterestBatch(batch);
+
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 4);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 2);
+  BOOST_REQUIRE_EQUAL(face3->sentInterests.size(), 2);
+  // names are processed in the order of their first arrival
+  BOOST_CHECK_EQUAL(face3->sentInterests[0].getName(), "/A/1");
+  BOOST_CHECK_EQUAL(face3->sentInterests[1].getName(), "/A/2");
+  BOOST_CHECK_EQUAL(face2->sentNacks.size(), 1); // Nack-Duplicate for the looped Interest
+
+  std::vector<Forwarder::IncomingData> dataBatch;
+  dataBatch.push_back({FaceEndpoint(*face3, 0), makeData("/A/2")});
+  dataBatch.push_back({FaceEndpoint(*face3, 0), makeData("/A/1")});
+  forwarder.startProcessDataBatch(dataBatch);
+
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 2);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), "/A/2");
+  BOOST_CHECK_EQUAL(face1->sentData[1].getName(), "/A/1");
+  BOOST_REQUIRE_EQUAL(face2->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face2->sentData[0].getName(), "/A/1");
+}
+
+BOOST_AUTO_TEST_CASE(Batching)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entry, *face2, 0);
+
+  forwarder.enableBatching(true);
+  face1->receiveInterest(*makeInterest("/A/1"), 0);
+  face1->receiveInterest(*makeInterest("/A/2"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 2);
+
+  // receiving Data processes the queued Interests first
+  face1->receiveInterest(*makeInterest("/A/3"), 0);
+  face2->receiveData(*makeData("/A/1"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 0);
+
+  // disabling processes the queued Data
+  forwarder.enableBatching(false);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 1);
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 1);
+
+  face2->receiveData(*makeData("/A/2"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestForwarder
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
@@ -481,6 +481,86 @@ BOOST_AUTO_TEST_CASE(Reload)
 
 BOOST_AUTO_TEST_SUITE_END() // NetworkRegion
 
+BOOST_AUTO_TEST_SUITE(DeadNonceListSection)
+
+BOOST_AUTO_TEST_CASE(BloomFilter)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      dead_nonce_list
+      {
+        mode bloom-filter
+        capacity 1000
+        false_positive_rate 0.01
+      }
+    }
+  )CONFIG";
+
+  DeadNonceList& dnl = forwarder.getDeadNonceList();
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(dnl.isBloomFilterEnabled(), false);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(dnl.isBloomFilterEnabled(), true);
+}
+
+BOOST_AUTO_TEST_CASE(Exact)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      dead_nonce_list
+      {
+        mode exact
+      }
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getDeadNonceList().isBloomFilterEnabled(), false);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      dead_nonce_list
+      {
+        mode cuckoo
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      dead_nonce_list
+      {
+        mode bloom-filter
+        capacity 0
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+
+  const std::string CONFIG3 = R"CONFIG(
+    tables
+    {
+      dead_nonce_list
+      {
+        mode bloom-filter
+        false_positive_rate 1.5
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(runConfig(CONFIG3, true), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DeadNonceListSection
+
 BOOST_AUTO_TEST_SUITE_END() // TestTablesConfigSection
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
 
@@ -143,6 +143,71 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(ExactName_SameName)
+{
+  Name n1 = insert(1, "/A", [] (Data& data) { data.setFreshnessPeriod(1_h); });
+  Name n2 = insert(2, "/A");
+  Name n3 = insert(3, "/A/B");
+
+  // the match is the same as a search of the ordered table would return
+  startInterest("/A");
+  CHECK_CS_FIND(n1 < n2 ? 1 : 2);
+
+  advanceClocks(500_ms);
+  startInterest("/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(1);
+
+  startInterest(n3);
+  CHECK_CS_FIND(3);
+}
+
+BOOST_AUTO_TEST_CASE(ExactName_AfterErase)
+{
+  insert(1, "/A/1");
+  insert(2, "/A/2");
+  insert(3, "/B");
+
+  BOOST_CHECK_EQUAL(erase("/A", 1), 1);
+  startInterest("/A/1");
+  CHECK_CS_FIND(0);
+  startInterest("/A/2");
+  CHECK_CS_FIND(2);
+
+  cs.setLimit(1);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  startInterest("/A/2");
+  find([&] (uint32_t found) { BOOST_CHECK_EQUAL(found, cs.begin()->getName() == "/A/2" ? 2 : 0); });
+  startInterest("/B");
+  find([&] (uint32_t found) { BOOST_CHECK_EQUAL(found, cs.begin()->getName() == "/B" ? 3 : 0); });
+}
+
+BOOST_AUTO_TEST_CASE(PrefixMatchDisabled)
+{
+  Name n1 = insert(1, "/A");
+  insert(2, "/B/p");
+
+  BOOST_CHECK_EQUAL(cs.shouldMatchPrefix(), true);
+  cs.enablePrefixMatch(false);
+  BOOST_CHECK_EQUAL(cs.shouldMatchPrefix(), false);
+
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest(n1);
+  CHECK_CS_FIND(1);
+  startInterest("/B")
+    .setCanBePrefix(true);
+  CHECK_CS_FIND(0);
+  startInterest("/A")
+    .setCanBePrefix(true);
+  CHECK_CS_FIND(0);
+
+  cs.enablePrefixMatch(true);
+  startInterest("/B")
+    .setCanBePrefix(true);
+  CHECK_CS_FIND(2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 
 BOOST_AUTO_TEST_CASE(Erase)
@@ -157,6 +157,55 @@ BOOST_FIXTURE_TEST_CASE(CapacityUp, PeriodicalInsertionFixture)
   BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
 }
 
+BOOST_FIXTURE_TEST_CASE(BloomFilterLifetime, PeriodicalInsertionFixture)
+{
+  BOOST_CHECK_THROW(dnl.enableBloomFilter(0, 0.01), std::invalid_argument);
+  BOOST_CHECK_THROW(dnl.enableBloomFilter(1000, 0.0), std::invalid_argument);
+  BOOST_CHECK_THROW(dnl.enableBloomFilter(1000, 1.0), std::invalid_argument);
+  BOOST_CHECK_EQUAL(dnl.isBloomFilterEnabled(), false);
+
+  dnl.enableBloomFilter(1000, 0.01);
+  BOOST_CHECK_EQUAL(dnl.isBloomFilterEnabled(), true);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+
+  this->setRate(500);
+  this->advanceClocksByLifetime(10.0);
+
+  Name nameC("ndn:/C");
+  const uint32_t nonceC = 0x25390656;
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+  dnl.add(nameC, nonceC);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.99); // entry is kept for at least one lifetime
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(1.02); // and at most two lifetimes
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+}
+
+BOOST_AUTO_TEST_CASE(BloomFilterFalsePositiveRate)
+{
+  DeadNonceList dnl;
+  dnl.enableBloomFilter(10000, 0.01);
+
+  Name nameA("ndn:/A");
+  for (uint32_t nonce = 0; nonce < 10000; ++nonce) {
+    dnl.add(nameA, nonce);
+  }
+  BOOST_CHECK_EQUAL(dnl.size(), 10000);
+  for (uint32_t nonce = 0; nonce < 10000; ++nonce) {
+    BOOST_REQUIRE_EQUAL(dnl.has(nameA, nonce), true);
+  }
+
+  Name nameB("ndn:/B");
+  int nFalsePositives = 0;
+  for (uint32_t nonce = 0; nonce < 10000; ++nonce) {
+    nFalsePositives += static_cast<int>(dnl.has(nameB, nonce));
+  }
+  BOOST_CHECK_LT(nFalsePositives, 200);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestDeadNonceList
 BOOST_AUTO_TEST_SUITE_END() // Table
 
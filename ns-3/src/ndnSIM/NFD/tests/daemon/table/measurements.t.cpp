@@ -88,6 +88,27 @@ BOOST_AUTO_TEST_CASE(GetLongName)
   BOOST_CHECK_EQUAL(entry3.getName().size(), NameTree::getMaxDepth());
 }
 
+BOOST_AUTO_TEST_CASE(GetWithPrefixView)
+{
+  Name name("/A/B/C");
+
+  Entry& entryAB = measurements.get(PrefixView(name, 2));
+  BOOST_CHECK_EQUAL(entryAB.getName(), "/A/B");
+  BOOST_CHECK_EQUAL(&measurements.get("/A/B"), &entryAB);
+  BOOST_CHECK_EQUAL(measurements.findExactMatch(PrefixView(name, 2)), &entryAB);
+  BOOST_CHECK(measurements.findExactMatch(PrefixView(name)) == nullptr);
+
+  Entry& entry0 = measurements.get(PrefixView(name, 0));
+  BOOST_CHECK_EQUAL(entry0.getName(), "/");
+
+  Name n;
+  while (n.size() < NameTree::getMaxDepth() + 2) {
+    n.append("A");
+  }
+  Entry& entryLong = measurements.get(PrefixView(n, n.size() - 1));
+  BOOST_CHECK_EQUAL(entryLong.getName().size(), NameTree::getMaxDepth());
+}
+
 BOOST_AUTO_TEST_CASE(GetWithFibEntry)
 {
   Fib fib(nameTree);
@@ -53,6 +53,48 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
   BOOST_CHECK_EQUAL(hashes.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(ComputeHashOrderSensitive)
+{
+  BOOST_CHECK_NE(computeHash("/A/B"), computeHash("/B/A"));
+  BOOST_CHECK_NE(computeHash("/A/A"), computeHash("/"));
+  BOOST_CHECK_NE(computeHash("/A/B/A"), computeHash("/B"));
+
+  Name name("/A/B/C");
+  HashSequence hashes = computeHashes(name);
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], computeHash(name, i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GetHashes)
+{
+  auto interest = makeInterest("/A/B/C");
+  const HashSequence& hashes = getHashes(*interest);
+  BOOST_CHECK(hashes == computeHashes(interest->getName()));
+  BOOST_CHECK_EQUAL(&getHashes(*interest), &hashes); // cached on the packet
+
+  auto data = makeData("/A/B");
+  BOOST_CHECK(getHashes(*data) == computeHashes(data->getName()));
+}
+
+BOOST_AUTO_TEST_CASE(GetHashesAfterSetName)
+{
+  // a new name with as many components must not reuse the cached sequence
+  auto interest = makeInterest("/A/B/C");
+  getHashes(*interest);
+  interest->setName("/D/E/F");
+  BOOST_CHECK(getHashes(*interest) == computeHashes("/D/E/F"));
+
+  auto data = makeData("/A/B");
+  getHashes(*data);
+  data->setName("/C/D");
+  BOOST_CHECK(getHashes(*data) == computeHashes("/C/D"));
+
+  // copies of a packet share its name encoding and the cached sequence
+  Interest copy(*interest);
+  BOOST_CHECK_EQUAL(&getHashes(copy), &getHashes(*interest));
+}
+
 BOOST_AUTO_TEST_SUITE(Hashtable)
 using name_tree::Hashtable;
 
@@ -183,6 +225,125 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_SUITE(OpenAddressing)
+
+BOOST_AUTO_TEST_CASE(Modifiers)
+{
+  HashtableOptions options(16);
+  options.backend = HashtableBackend::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 21); // rounded up to whole groups
+
+  Name name("/A/B/C/D");
+  HashSequence hashes = computeHashes(name);
+
+  const Node* node = nullptr;
+  bool isNew = false;
+  std::tie(node, isNew) = ht.insert(name, 2, hashes);
+  BOOST_CHECK_EQUAL(isNew, true);
+  BOOST_REQUIRE(node != nullptr);
+  BOOST_CHECK_EQUAL(node->entry.getName(), "/A/B");
+  BOOST_CHECK_EQUAL(ht.size(), 1);
+  BOOST_CHECK_EQUAL(ht.find(name, 2), node);
+  BOOST_CHECK_EQUAL(ht.find(name, 2, hashes), node);
+  BOOST_CHECK(ht.find(name, 1) == nullptr);
+  BOOST_CHECK(ht.find(name, 3) == nullptr);
+
+  std::tie(node, isNew) = ht.insert(name, 2, hashes);
+  BOOST_CHECK_EQUAL(isNew, false);
+  BOOST_CHECK_EQUAL(ht.size(), 1);
+
+  ht.erase(const_cast<Node*>(node));
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK(ht.find(name, 2) == nullptr);
+  BOOST_CHECK(ht.getFirstNode() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalResize)
+{
+  HashtableOptions options(16);
+  options.backend = HashtableBackend::OPEN_ADDRESSING;
+  Hashtable ht(options);
+
+  auto makeName = [] (int i) {
+    Name name;
+    name.appendNumber(i);
+    return name;
+  };
+
+  const int N_NODES = 2000;
+  bool hasResized = false;
+  for (int i = 0; i < N_NODES; ++i) {
+    Name name = makeName(i);
+    BOOST_CHECK_EQUAL(ht.insert(name, 1, computeHashes(name)).second, true);
+    hasResized = hasResized || ht.isResizing();
+    if (ht.isResizing()) {
+      // every node is reachable while nodes are being moved
+      for (int j = 0; j <= i; ++j) {
+        BOOST_REQUIRE(ht.find(makeName(j), 1) != nullptr);
+      }
+    }
+  }
+  BOOST_CHECK(hasResized);
+  BOOST_CHECK_EQUAL(ht.size(), N_NODES);
+  BOOST_CHECK_GE(ht.getNBuckets(), 2 * N_NODES);
+
+  size_t nEnumerated = 0;
+  for (const Node* node = ht.getFirstNode(); node != nullptr; node = ht.getNextNode(node)) {
+    ++nEnumerated;
+  }
+  BOOST_CHECK_EQUAL(nEnumerated, N_NODES);
+
+  for (int i = 1; i < N_NODES; i += 2) {
+    const Node* node = ht.find(makeName(i), 1);
+    BOOST_REQUIRE(node != nullptr);
+    ht.erase(const_cast<Node*>(node));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), N_NODES / 2);
+  for (int i = 0; i < N_NODES; ++i) {
+    BOOST_CHECK_EQUAL(ht.find(makeName(i), 1) != nullptr, i % 2 == 0);
+  }
+
+  for (int i = 0; i < N_NODES; i += 2) {
+    const Node* node = ht.find(makeName(i), 1);
+    BOOST_REQUIRE(node != nullptr);
+    ht.erase(const_cast<Node*>(node));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 21);
+}
+
+BOOST_AUTO_TEST_CASE(Churn)
+{
+  HashtableOptions options(16);
+  options.backend = HashtableBackend::OPEN_ADDRESSING;
+  Hashtable ht(options);
+
+  auto makeName = [] (int i) {
+    Name name;
+    name.appendNumber(i);
+    return name;
+  };
+
+  // a sliding window of 40 live nodes; DELETED slots must not make the table grow
+  for (int i = 0; i < 20000; ++i) {
+    Name name = makeName(i);
+    ht.insert(name, 1, computeHashes(name));
+    if (i >= 40) {
+      const Node* node = ht.find(makeName(i - 40), 1);
+      BOOST_REQUIRE(node != nullptr);
+      ht.erase(const_cast<Node*>(node));
+    }
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 40);
+  BOOST_CHECK_LE(ht.getNBuckets(), 256);
+  for (int i = 20000 - 40; i < 20000; ++i) {
+    BOOST_CHECK(ht.find(makeName(i), 1) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // OpenAddressing
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -293,6 +454,25 @@ BOOST_AUTO_TEST_CASE(TableEntries)
 
 BOOST_AUTO_TEST_SUITE_END() // TestEntry
 
+BOOST_AUTO_TEST_CASE(LookupWithHashes)
+{
+  NameTree nt(16);
+  Name name("/A/B/C");
+  HashSequence hashes = computeHashes(name);
+
+  Entry& nteAB = nt.lookup(name, 2, hashes);
+  BOOST_CHECK_EQUAL(nteAB.getName(), "/A/B");
+  BOOST_CHECK_EQUAL(nt.size(), 3);
+  BOOST_CHECK_EQUAL(&nt.lookup("/A/B"), &nteAB);
+
+  BOOST_CHECK_EQUAL(nt.findExactMatch(name, 2, hashes), &nteAB);
+  BOOST_CHECK(nt.findExactMatch(name, 3, hashes) == nullptr);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(name, hashes), &nteAB);
+
+  auto&& matches = nt.findAllMatches(name, hashes);
+  BOOST_CHECK_EQUAL(std::distance(matches.begin(), matches.end()), 3);
+}
+
 BOOST_AUTO_TEST_CASE(Basic)
 {
   size_t nBuckets = 16;
@@ -526,6 +706,30 @@ BOOST_FIXTURE_TEST_CASE(IteratorFullEnumerate, EnumerationFixture)
     .end();
 }
 
+BOOST_AUTO_TEST_CASE(IteratorFullEnumerateOpenAddressing)
+{
+  HashtableOptions options(16);
+  options.backend = HashtableBackend::OPEN_ADDRESSING;
+  NameTree nt(options);
+
+  nt.lookup("/a/b/c");
+  nt.lookup("/a/b/d");
+  nt.lookup("/a/e");
+  nt.lookup("/f");
+  BOOST_CHECK_EQUAL(nt.size(), 7);
+
+  auto&& enumerable = nt.fullEnumerate();
+  EnumerationVerifier(enumerable)
+    .expect("/")
+    .expect("/a")
+    .expect("/a/b")
+    .expect("/a/b/c")
+    .expect("/a/b/d")
+    .expect("/a/e")
+    .expect("/f")
+    .end();
+}
+
 BOOST_FIXTURE_TEST_SUITE(IteratorPartialEnumerate, EnumerationFixture)
 
 BOOST_AUTO_TEST_CASE(Empty)
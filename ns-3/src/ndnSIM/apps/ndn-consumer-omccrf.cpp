@@ -1,5 +1,6 @@
 #include "ndn-consumer-omccrf.hpp"
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/lp/route-label.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerOMCCRF");
 
@@ -13,6 +14,20 @@ namespace ns3 {
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
         double RouteMonitor::pMax = 0.5;
+
+        /// face indices of each hop, from the producer side, or the raw value of a hashed label
+        static std::string
+        FormatRouteLabel(uint64_t label) {
+            auto hops = ::ndn::lp::route_label::decode(label);
+            if (!hops) {
+                return "#" + std::to_string(label);
+            }
+            std::string path;
+            for (auto hop : *hops) {
+                path += "/" + std::to_string(hop);
+            }
+            return path;
+        }
         constexpr uint32_t ConsumerOMCCRF::BIC_MAX_INCREMENT;
         constexpr uint32_t ConsumerOMCCRF::BIC_LOW_WINDOW;
 
@@ -34,6 +49,20 @@ namespace ns3 {
                                 EnumValue(CcAlgorithm::AIMD),
                                 MakeEnumAccessor(&ConsumerOMCCRF::m_ccAlgorithm),
                                 MakeEnumChecker(CcAlgorithm::AIMD, "AIMD", CcAlgorithm::BIC, "BIC"))
+                .AddAttribute("RouteWindowSize",
+                            "Number of RTT samples per route over which the minimum and maximum RTT are tracked",
+                            UintegerValue(30),
+                            MakeUintegerAccessor(&ConsumerOMCCRF::m_routeWindowSize),
+                            MakeUintegerChecker<uint32_t>(1))
+                .AddAttribute("RouteIdleTimeout",
+                            "Routes that deliver no Data for this long are forgotten (zero keeps them forever)",
+                            TimeValue(Seconds(0)),
+                            MakeTimeAccessor(&ConsumerOMCCRF::m_routeIdleTimeout),
+                            MakeTimeChecker())
+                .AddTraceSource("RouteCount",
+                                "Number of routes currently tracked",
+                                MakeTraceSourceAccessor(&ConsumerOMCCRF::m_routeCount),
+                                "ns3::TracedValueCallback::Uint32")
                 .AddAttribute("PMax",
                             "最大窗口下降概率",
                             DoubleValue(0.5),
@@ -55,27 +84,29 @@ namespace ns3 {
             if (m_inFlight > static_cast<uint32_t>(0))
                 m_inFlight--;
 
-            uint64_t sequenceNum = data->getName().get(-1).toSequenceNumber();
-            if (this->inFlightInterest.count(sequenceNum) != 0) {
-                double rtt = (Simulator::Now() - this->inFlightInterest[sequenceNum]).ToDouble(Time::S);
+            uint32_t sequenceNum = data->getName().get(-1).toSequenceNumber();
+            auto record = this->inFlightInterest.find(sequenceNum);
+            if (record != nullptr) {
+                double rtt = (Simulator::Now() - record->sendTime).ToDouble(Time::S);
+                this->inFlightInterest.erase(sequenceNum);
 
                 // 取出 RouteLabel，区分不同的路由
                 auto routeLabel = data->getTag<lp::RouteLabelTag>();
                 if (routeLabel != nullptr) {
                     auto routeLabelValue = routeLabel->get();
-                    if (this->routes.count(routeLabelValue) == 0) {
-                        this->routes[routeLabelValue] = std::make_shared<RouteMonitor>();
-                    }
-                    if (this->routes[routeLabelValue]->appendRTT(rtt)) {
+                    NS_LOG_LOGIC("Data " << sequenceNum << " came over route " << FormatRouteLabel(routeLabelValue));
+                    RouteMonitor& route = this->routes.touch(routeLabelValue, Simulator::Now(), m_routeWindowSize);
+                    m_routeCount = this->routes.size();
+                    if (route.appendRTT(rtt)) {
                         this->WindowDecrease();
                     } else {
                         this->WindowIncrease();
                     }
                 } else {
-                    std::cout << "Data have no route label" << std::endl;
+                    NS_LOG_WARN("Data " << sequenceNum << " carries no route label");
                 }
             } else {
-                std::cout << "inFlight Record is null???" << std::endl;
+                NS_LOG_WARN("Data " << sequenceNum << " matches no Interest in flight");
             }
 
             ScheduleNextPacket();
@@ -98,6 +129,8 @@ namespace ns3 {
         ConsumerOMCCRF::OnNack(shared_ptr<const lp::Nack> nack) {
             // std::cout << "OnNack" << std::endl;
             Consumer::OnNack(nack);
+
+            this->inFlightInterest.erase(nack->getInterest().getName().get(-1).toSequenceNumber());
         }
 
         void
@@ -105,7 +138,32 @@ namespace ns3 {
             // std::cout << "Will Send Interest" << std::endl;
             ConsumerWindow::WillSendOutInterest(sequenceNumber);
 
-            this->inFlightInterest[sequenceNumber] = Simulator::Now();
+            this->inFlightInterest.reserve(static_cast<size_t>(m_window) + 1);
+            this->inFlightInterest.insert(sequenceNumber, Simulator::Now());
+        }
+
+        void
+        ConsumerOMCCRF::StartApplication() {
+            ConsumerWindow::StartApplication();
+
+            if (m_routeIdleTimeout.IsStrictlyPositive()) {
+                m_routeExpiryEvent = Simulator::Schedule(m_routeIdleTimeout, &ConsumerOMCCRF::ExpireIdleRoutes, this);
+            }
+        }
+
+        void
+        ConsumerOMCCRF::StopApplication() {
+            Simulator::Cancel(m_routeExpiryEvent);
+
+            ConsumerWindow::StopApplication();
+        }
+
+        void
+        ConsumerOMCCRF::ExpireIdleRoutes() {
+            this->routes.expire(Simulator::Now() - m_routeIdleTimeout);
+            m_routeCount = this->routes.size();
+
+            m_routeExpiryEvent = Simulator::Schedule(m_routeIdleTimeout, &ConsumerOMCCRF::ExpireIdleRoutes, this);
         }
 
         void
@@ -218,39 +276,284 @@ namespace ns3 {
             , deltaPMax(pMax - pMin)
             , pr(pMin)
             , maxWindowSize(maxWindowSize)
-            , lastDecreaseTime(Simulator::Now()) {
+            , lastDecreaseTime(Simulator::Now())
+            , sampleWindow(maxWindowSize) {
 
         }
 
+        void
+        RouteMonitor::reset(size_t maxWindowSize) {
+            if (maxWindowSize != this->maxWindowSize) {
+                *this = RouteMonitor(maxWindowSize);
+                return;
+            }
+            RMin = std::numeric_limits<double>::max();
+            RMax = 0;
+            deltaPMax = pMax - pMin;
+            pr = pMin;
+            lastDecreaseTime = Simulator::Now();
+            sampleWindow.clear();
+        }
+
         bool
         RouteMonitor::appendRTT(double rtt) {
-            if (sampleWindow.size() < maxWindowSize) {
-                sampleWindow.push_back(rtt);
+            sampleWindow.push(rtt);
+            if (sampleWindow.count() <= maxWindowSize) {
                 return false;
             }
 
-            sampleWindow.pop_front();
-            sampleWindow.push_back(rtt);
-            RMin = sampleWindow.back();
-            RMax = sampleWindow.back();
-            for (auto it = sampleWindow.begin(); it != sampleWindow.end(); it++) {
-                if ((*it) < RMin) {
-                    RMin = (*it);
-                }
-                if ((*it) > RMax) {
-                    RMax = (*it);
-                }
-            }
+            RMin = sampleWindow.min();
+            RMax = sampleWindow.max();
             auto deltaRMax = RMax - RMin;
             if (deltaRMax < 10e-5) {
                 pr = pMin;
             } else {
-                pr = pMin + deltaPMax * (sampleWindow.back() - RMin) / deltaRMax;
+                pr = pMin + deltaPMax * (rtt - RMin) / deltaRMax;
             }
 
             double r = ((double)rand() / (RAND_MAX));
             
             return r <= pr;
         }
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        //// InFlightRing
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        InFlightRing::InFlightRing(size_t capacity)
+            : mask(0)
+            , nInFlight(0) {
+            grow(capacity);
+        }
+
+        void
+        InFlightRing::insert(uint32_t seq, Time now) {
+            Record* slot = &slots[seq & mask];
+            while (slot->isInFlight && slot->seq != seq) {
+                grow(slots.size() * 2);
+                slot = &slots[seq & mask];
+            }
+
+            if (slot->isUsed && slot->seq == seq) {
+                slot->nRetx++;
+            } else {
+                slot->seq = seq;
+                slot->nRetx = 0;
+            }
+            if (!slot->isInFlight) {
+                nInFlight++;
+            }
+            slot->sendTime = now;
+            slot->isUsed = true;
+            slot->isInFlight = true;
+        }
+
+        const InFlightRing::Record*
+        InFlightRing::find(uint32_t seq) const {
+            const Record& slot = slots[seq & mask];
+            return slot.isInFlight && slot.seq == seq ? &slot : nullptr;
+        }
+
+        void
+        InFlightRing::erase(uint32_t seq) {
+            Record& slot = slots[seq & mask];
+            if (slot.isInFlight && slot.seq == seq) {
+                slot.isInFlight = false;
+                nInFlight--;
+            }
+        }
+
+        void
+        InFlightRing::reserve(size_t capacity) {
+            if (capacity > slots.size()) {
+                grow(capacity);
+            }
+        }
+
+        void
+        InFlightRing::grow(size_t capacity) {
+            size_t newSize = 1;
+            while (newSize < capacity) {
+                newSize *= 2;
+            }
+
+            std::vector<Record> oldSlots(newSize, Record{0, Time(0), 0, false, false});
+            oldSlots.swap(slots);
+            mask = newSize - 1;
+
+            // records still in flight are rehashed; doubling again if two of them collide
+            for (const auto& record : oldSlots) {
+                if (!record.isInFlight) {
+                    continue;
+                }
+                if (slots[record.seq & mask].isInFlight) {
+                    slots.swap(oldSlots);
+                    grow(newSize * 2);
+                    return;
+                }
+                slots[record.seq & mask] = record;
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        //// RouteRegistry
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        constexpr size_t RouteRegistry::INITIAL_BUCKETS;
+        constexpr uint32_t RouteRegistry::EMPTY;
+
+        RouteRegistry::RouteRegistry()
+            : index(INITIAL_BUCKETS, EMPTY)
+            , nRoutes(0) {
+
+        }
+
+        uint64_t
+        RouteRegistry::hashLabel(uint64_t label) {
+            label ^= label >> 30;
+            label *= 0xbf58476d1ce4e5b9ULL;
+            label ^= label >> 27;
+            label *= 0x94d049bb133111ebULL;
+            label ^= label >> 31;
+            return label;
+        }
+
+        size_t
+        RouteRegistry::bucketOf(uint64_t label) const {
+            return hashLabel(label) & (index.size() - 1);
+        }
+
+        RouteMonitor&
+        RouteRegistry::touch(uint64_t label, Time now, size_t windowSize) {
+            size_t bucket = bucketOf(label);
+            while (index[bucket] != EMPTY) {
+                Route& route = pool[index[bucket] - 1];
+                if (route.label == label) {
+                    route.lastData = now;
+                    return route.monitor;
+                }
+                bucket = (bucket + 1) & (index.size() - 1);
+            }
+
+            uint32_t slot;
+            if (freeSlots.empty()) {
+                slot = static_cast<uint32_t>(pool.size());
+                pool.push_back(Route{label, now, RouteMonitor(windowSize), true});
+            } else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                Route& route = pool[slot];
+                route.label = label;
+                route.lastData = now;
+                route.monitor.reset(windowSize);
+                route.isLive = true;
+            }
+            index[bucket] = slot + 1;
+            nRoutes++;
+
+            // keep the load factor at most 1/2
+            if (nRoutes * 2 > index.size()) {
+                rehash(index.size() * 2);
+            }
+            return pool[slot].monitor;
+        }
+
+        void
+        RouteRegistry::expire(Time cutoff) {
+            for (size_t bucket = 0; bucket < index.size();) {
+                if (index[bucket] != EMPTY && pool[index[bucket] - 1].lastData < cutoff) {
+                    // backward shifting may move another entry into this bucket, so look at it again
+                    eraseFromIndex(bucket);
+                } else {
+                    bucket++;
+                }
+            }
+        }
+
+        void
+        RouteRegistry::eraseFromIndex(size_t bucket) {
+            uint32_t slot = index[bucket] - 1;
+            pool[slot].isLive = false;
+            freeSlots.push_back(slot);
+            nRoutes--;
+
+            // backward shift deletion: pull later entries of the probe sequence into the hole
+            size_t mask = index.size() - 1;
+            size_t hole = bucket;
+            for (size_t next = (hole + 1) & mask; index[next] != EMPTY; next = (next + 1) & mask) {
+                size_t home = bucketOf(pool[index[next] - 1].label);
+                // the entry may move only if its home bucket is not cyclically within (hole, next]
+                if (((next - home) & mask) >= ((next - hole) & mask)) {
+                    index[hole] = index[next];
+                    hole = next;
+                }
+            }
+            index[hole] = EMPTY;
+        }
+
+        void
+        RouteRegistry::rehash(size_t nBuckets) {
+            index.assign(nBuckets, EMPTY);
+            for (uint32_t slot = 0; slot < pool.size(); slot++) {
+                if (!pool[slot].isLive) {
+                    continue;
+                }
+                size_t bucket = bucketOf(pool[slot].label);
+                while (index[bucket] != EMPTY) {
+                    bucket = (bucket + 1) & (nBuckets - 1);
+                }
+                index[bucket] = slot + 1;
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        //// SlidingMinMax
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SlidingMinMax::SlidingMinMax(size_t capacity)
+            : capacity(capacity)
+            , nSamples(0)
+            , values(capacity)
+            , minQueue(capacity)
+            , maxQueue(capacity) {
+
+        }
+
+        void
+        SlidingMinMax::push(double sample) {
+            uint64_t index = nSamples++;
+            values[index % capacity] = sample;
+
+            // drop the index that just left the window, then the candidates the new sample dominates
+            if (!minQueue.empty() && minQueue.front() + capacity <= index) {
+                minQueue.popFront();
+            }
+            while (!minQueue.empty() && values[minQueue.back() % capacity] >= sample) {
+                minQueue.popBack();
+            }
+            minQueue.pushBack(index);
+
+            if (!maxQueue.empty() && maxQueue.front() + capacity <= index) {
+                maxQueue.popFront();
+            }
+            while (!maxQueue.empty() && values[maxQueue.back() % capacity] <= sample) {
+                maxQueue.popBack();
+            }
+            maxQueue.pushBack(index);
+        }
+
+        void
+        SlidingMinMax::clear() {
+            nSamples = 0;
+            minQueue.clear();
+            maxQueue.clear();
+        }
+
+        SlidingMinMax::IndexQueue::IndexQueue(size_t capacity)
+            : slots(capacity)
+            , head(0)
+            , size(0) {
+
+        }
     }
 }
@@ -3,8 +3,8 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ndn-consumer-window.hpp"
-#include <unordered_map>
-#include <queue>
+#include "ns3/traced-value.h"
+#include <vector>
 
 namespace ns3 {
     namespace ndn {
@@ -13,12 +13,138 @@ namespace ns3 {
             AIMD,
             BIC
         };
+        /**
+         * @brief Minimum and maximum of the last N samples, updated in amortized O(1)
+         *
+         * Samples are kept in a preallocated ring buffer. Two monotonic queues of sample indices, also
+         * ring buffers, keep the candidates for the window minimum and maximum at their fronts.
+         */
+        class SlidingMinMax {
+        public:
+            explicit SlidingMinMax(size_t capacity);
+
+            void push(double sample);
+
+            /// forget all samples, keeping the buffers
+            void clear();
+
+            /// number of samples pushed so far, including those that left the window
+            uint64_t count() const {
+                return nSamples;
+            }
+
+            double min() const {
+                return values[minQueue.front() % capacity];
+            }
+
+            double max() const {
+                return values[maxQueue.front() % capacity];
+            }
+
+        private:
+            /// fixed-capacity deque of sample indices
+            class IndexQueue {
+            public:
+                explicit IndexQueue(size_t capacity);
+
+                bool empty() const {
+                    return size == 0;
+                }
+
+                uint64_t front() const {
+                    return slots[head];
+                }
+
+                uint64_t back() const {
+                    return slots[(head + size - 1) % slots.size()];
+                }
+
+                void popFront() {
+                    head = (head + 1) % slots.size();
+                    size--;
+                }
+
+                void popBack() {
+                    size--;
+                }
+
+                void pushBack(uint64_t index) {
+                    slots[(head + size) % slots.size()] = index;
+                    size++;
+                }
+
+                void clear() {
+                    head = 0;
+                    size = 0;
+                }
+
+            private:
+                std::vector<uint64_t> slots;
+                size_t head;
+                size_t size;
+            };
+
+            size_t capacity;
+            uint64_t nSamples;
+            std::vector<double> values;
+            IndexQueue minQueue;   // indices of increasing values
+            IndexQueue maxQueue;   // indices of decreasing values
+        };
+
+        /**
+         * @brief Send times of outstanding Interests, indexed by sequence number modulo capacity
+         *
+         * Sequence numbers in flight are dense and bounded by the congestion window, so a ring buffer
+         * replaces hashing. The capacity is a power of two and doubles whenever a new sequence number
+         * would land on the slot of another one that is still in flight. A released slot remembers its
+         * sequence number until it is reused, so that retransmissions are counted.
+         */
+        class InFlightRing {
+        public:
+            struct Record {
+                uint32_t seq;
+                Time sendTime;
+                uint32_t nRetx;
+                bool isUsed;        ///< whether seq is meaningful
+                bool isInFlight;
+            };
+
+            explicit InFlightRing(size_t capacity = 64);
+
+            /// record that @p seq has been sent (or retransmitted) at @p now
+            void insert(uint32_t seq, Time now);
+
+            /// @return the record of @p seq if it is in flight, otherwise nullptr
+            const Record* find(uint32_t seq) const;
+
+            /// release the slot of @p seq, if it is in flight
+            void erase(uint32_t seq);
+
+            /// grow to hold at least @p capacity consecutive sequence numbers
+            void reserve(size_t capacity);
+
+            size_t size() const {
+                return nInFlight;
+            }
+
+        private:
+            void grow(size_t capacity);
+
+        private:
+            std::vector<Record> slots;
+            size_t mask;
+            size_t nInFlight;
+        };
+
         class RouteMonitor {
         public:
             explicit RouteMonitor(size_t maxWindowSize = 30);
 
             bool appendRTT(double rtt);
 
+            /// start over as a new route, reusing the sample buffers when the window size is unchanged
+            void reset(size_t maxWindowSize);
+
             static double pMax;                            
 
         private:
@@ -29,7 +155,65 @@ namespace ns3 {
             double pr;                              
             size_t maxWindowSize;                   
             Time lastDecreaseTime;                  
-            std::deque<double> sampleWindow;        
+            SlidingMinMax sampleWindow;
+        };
+
+        /**
+         * @brief RouteMonitors of a consumer, keyed by RouteLabel
+         *
+         * Monitors live inline in a contiguous pool whose slots are recycled, and are found through a
+         * small open-addressing index with linear probing. Routes that have not delivered Data for a
+         * while can be expired.
+         */
+        class RouteRegistry {
+        public:
+            /// number of index buckets of an empty registry
+            static constexpr size_t INITIAL_BUCKETS = 16;
+
+            RouteRegistry();
+
+            /**
+             * @brief hash of @p label whose low bits select its home bucket in the index
+             *
+             * Labels of neighbouring routes differ only in a few bits, so they are mixed by the
+             * splitmix64 finalizer.
+             */
+            static uint64_t hashLabel(uint64_t label);
+
+            /**
+             * @brief find or create the monitor of @p label, recording that it delivered Data at @p now
+             * @param windowSize RTT window size of a newly created monitor
+             */
+            RouteMonitor& touch(uint64_t label, Time now, size_t windowSize);
+
+            /// remove all routes that have not delivered Data since @p cutoff
+            void expire(Time cutoff);
+
+            size_t size() const {
+                return nRoutes;
+            }
+
+        private:
+            struct Route {
+                uint64_t label;
+                Time lastData;
+                RouteMonitor monitor;
+                bool isLive;
+            };
+
+            static constexpr uint32_t EMPTY = 0; ///< index entries hold pool position + 1
+
+            size_t bucketOf(uint64_t label) const;
+
+            void rehash(size_t nBuckets);
+
+            void eraseFromIndex(size_t bucket);
+
+        private:
+            std::vector<Route> pool;
+            std::vector<uint32_t> freeSlots;
+            std::vector<uint32_t> index;
+            size_t nRoutes;
         };
 
         class ConsumerOMCCRF : public ConsumerWindow {
@@ -51,7 +235,17 @@ namespace ns3 {
             virtual void
             WillSendOutInterest(uint32_t sequenceNumber) override;
 
+        protected:
+            virtual void
+            StartApplication() override;
+
+            virtual void
+            StopApplication() override;
+
         private:
+            void
+            ExpireIdleRoutes();
+
             void
             WindowIncrease();
 
@@ -73,8 +267,12 @@ namespace ns3 {
             }
             
         private:
-            std::unordered_map<uint32_t, Time> inFlightInterest;
-            std::unordered_map<uint64_t, std::shared_ptr<RouteMonitor>> routes;
+            InFlightRing inFlightInterest;
+            RouteRegistry routes;
+            uint32_t m_routeWindowSize;
+            Time m_routeIdleTimeout;
+            EventId m_routeExpiryEvent;
+            TracedValue<uint32_t> m_routeCount;
             Time lastDecreaseTime;                   
 
             double m_beta;
@@ -132,6 +132,38 @@ StackHelper::setPolicy(const std::string& policy)
   }
 }
 
+void
+StackHelper::setNameTreeBackend(const std::string& backend)
+{
+  if (backend != "chained" && backend != "open-addressing") {
+    NS_FATAL_ERROR("Name tree backend " << backend << " not found");
+  }
+  m_nameTreeBackend = backend;
+}
+
+void
+StackHelper::setCsPrefixMatch(bool isEnabled)
+{
+  m_isCsPrefixMatchEnabled = isEnabled;
+}
+
+void
+StackHelper::setForwarderBatching(bool isEnabled)
+{
+  m_isForwarderBatchingEnabled = isEnabled;
+}
+
+void
+StackHelper::setDeadNonceListBloomFilter(size_t capacity, double falsePositiveRate)
+{
+  if (capacity == 0 || !(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+    NS_FATAL_ERROR("Invalid Dead Nonce List Bloom filter capacity " << capacity
+                   << " or false positive rate " << falsePositiveRate);
+  }
+  m_dnlBloomFilterCapacity = capacity;
+  m_dnlFalsePositiveRate = falsePositiveRate;
+}
+
 void
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -173,6 +205,14 @@ StackHelper::doInstall(Ptr<Node> node) const
   }
 
   ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+  ndn->getConfig().put("ndnSIM.name_tree_backend", m_nameTreeBackend);
+  ndn->getConfig().put("ndnSIM.cs_prefix_match", m_isCsPrefixMatchEnabled);
+  ndn->getConfig().put("ndnSIM.forwarder_batching", m_isForwarderBatchingEnabled);
+  if (m_dnlBloomFilterCapacity > 0) {
+    ndn->getConfig().put("tables.dead_nonce_list.mode", "bloom-filter");
+    ndn->getConfig().put("tables.dead_nonce_list.capacity", m_dnlBloomFilterCapacity);
+    ndn->getConfig().put("tables.dead_nonce_list.false_positive_rate", m_dnlFalsePositiveRate);
+  }
 
   ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
 
@@ -85,6 +85,40 @@ public:
   void
   setPolicy(const std::string& policy);
 
+  /**
+   * @brief Set the hashtable backend of NFD's name tree
+   * @param backend "chained" (default) or "open-addressing"
+   */
+  void
+  setNameTreeBackend(const std::string& backend);
+
+  /**
+   * @brief Enable or disable serving Interests with CanBePrefix from NFD's Content Store
+   *
+   * Disable only when no consumer sets CanBePrefix: every Content Store lookup is then an
+   * exact-name hash lookup.
+   */
+  void
+  setCsPrefixMatch(bool isEnabled);
+
+  /**
+   * @brief Enable or disable batched packet processing in NFD's forwarder
+   *
+   * When enabled, Interests and Data delivered to a node at the same simulation time are
+   * processed as one batch, stage by stage. Packets of different names may then be processed
+   * in a different order than they were delivered.
+   */
+  void
+  setForwarderBatching(bool isEnabled);
+
+  /**
+   * @brief Record dead Nonces of NFD in a rotating pair of Bloom filters of fixed size
+   * @param capacity expected number of dead Nonces per lifetime of the Dead Nonce List
+   * @param falsePositiveRate probability that a fresh Interest is mistaken for a looping one
+   */
+  void
+  setDeadNonceListBloomFilter(size_t capacity, double falsePositiveRate);
+
   typedef Callback<shared_ptr<Face>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice>>
     FaceCreateCallback;
 
@@ -256,6 +290,11 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize = 100;
+  std::string m_nameTreeBackend = "chained";
+  bool m_isCsPrefixMatchEnabled = true;
+  bool m_isForwarderBatchingEnabled = false;
+  size_t m_dnlBloomFilterCapacity = 0; ///< 0 means the exact Dead Nonce List
+  double m_dnlFalsePositiveRate = 0;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
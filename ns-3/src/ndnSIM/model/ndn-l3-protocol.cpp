@@ -210,8 +210,13 @@ L3Protocol::~L3Protocol()
 void
 L3Protocol::initialize()
 {
+  ::nfd::name_tree::HashtableOptions nameTreeOptions(1024);
+  if (this->getConfig().get<std::string>("ndnSIM.name_tree_backend", "chained") == "open-addressing") {
+    nameTreeOptions.backend = ::nfd::name_tree::HashtableBackend::OPEN_ADDRESSING;
+  }
+
   m_impl->m_faceTable = make_unique<::nfd::FaceTable>();
-  m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable);
+  m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable, nameTreeOptions);
   m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
 
   initializeManagement();
@@ -289,6 +294,8 @@ L3Protocol::initializeManagement()
   ConfigFile config(&ConfigFile::ignoreUnknownSection);
 
   forwarder->getCs().setPolicy(m_impl->m_policy());
+  forwarder->getCs().enablePrefixMatch(this->getConfig().get<bool>("ndnSIM.cs_prefix_match", true));
+  forwarder->enableBatching(this->getConfig().get<bool>("ndnSIM.forwarder_batching", false));
 
   TablesConfigSection tablesConfig(*forwarder);
   tablesConfig.setConfigFile(config);
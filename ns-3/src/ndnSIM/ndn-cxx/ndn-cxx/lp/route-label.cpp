@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/route-label.hpp"
+
+namespace ndn {
+namespace lp {
+namespace route_label {
+
+const uint64_t HASHED_FLAG = uint64_t(1) << 63;
+const int LENGTH_SHIFT = 57;
+const uint64_t PAYLOAD_MASK = (uint64_t(1) << LENGTH_SHIFT) - 1;
+const int WIDTH_BITS = 4;
+const int MAX_WIDTH = 1 << WIDTH_BITS;
+
+static int
+bitWidth(uint64_t value)
+{
+  int width = 1;
+  while (width < 64 && (value >> width) != 0) {
+    ++width;
+  }
+  return width;
+}
+
+static uint64_t
+mix(uint64_t x)
+{
+  // splitmix64 finalizer
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+uint64_t
+appendHop(uint64_t label, uint64_t faceIndex) noexcept
+{
+  int width = bitWidth(faceIndex);
+
+  // a face index wider than a width prefix can describe is hashed like a hop that does not fit
+  if (!isHashed(label) && width <= MAX_WIDTH) {
+    int used = static_cast<int>(label >> LENGTH_SHIFT);
+    int needed = used + WIDTH_BITS + width;
+    if (needed <= LENGTH_SHIFT) {
+      uint64_t payload = label & PAYLOAD_MASK;
+      payload = (payload << WIDTH_BITS) | static_cast<uint64_t>(width - 1);
+      payload = (payload << width) | faceIndex;
+      return (static_cast<uint64_t>(needed) << LENGTH_SHIFT) | payload;
+    }
+  }
+
+  // the mixed previous label makes the hash depend on the order of the hops
+  return HASHED_FLAG | (mix(mix(label) + faceIndex) >> 1);
+}
+
+bool
+isHashed(uint64_t label) noexcept
+{
+  return (label & HASHED_FLAG) != 0;
+}
+
+optional<std::vector<uint64_t>>
+decode(uint64_t label)
+{
+  if (isHashed(label)) {
+    return nullopt;
+  }
+
+  int used = static_cast<int>(label >> LENGTH_SHIFT);
+  if (used > LENGTH_SHIFT || (label & PAYLOAD_MASK) >> used != 0) {
+    NDN_THROW(std::invalid_argument("Malformed RouteLabel"));
+  }
+
+  std::vector<uint64_t> hops;
+  while (used > 0) {
+    if (used < WIDTH_BITS + 1) {
+      NDN_THROW(std::invalid_argument("Malformed RouteLabel"));
+    }
+    used -= WIDTH_BITS;
+    int width = static_cast<int>((label >> used) & (MAX_WIDTH - 1)) + 1;
+    if (width > used) {
+      NDN_THROW(std::invalid_argument("Malformed RouteLabel"));
+    }
+    used -= width;
+    hops.push_back((label >> used) & ((uint64_t(1) << width) - 1));
+  }
+  return hops;
+}
+
+} // namespace route_label
+} // namespace lp
+} // namespace ndn
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_ROUTE_LABEL_HPP
+#define NDN_CXX_LP_ROUTE_LABEL_HPP
+
+#include "ndn-cxx/detail/common.hpp"
+
+#include <vector>
+
+namespace ndn {
+namespace lp {
+
+/** \brief encoding of RouteLabel values
+ *
+ *  A RouteLabel identifies the path a Data packet has travelled. Every forwarder on the way back
+ *  appends one hop: the index of the face the Data arrived on, in a field just wide enough for that
+ *  index. Each hop is prefixed by its width, so the label can be decoded without knowing the
+ *  topology, and a path keeps its label when faces are added to a forwarder on it. The layout,
+ *  from the most significant bit, is:
+ *
+ *  - 1 bit: hashed flag, clear
+ *  - 6 bits: number of payload bits in use
+ *  - 57 bits: payload; each hop is a 4-bit (width - 1) followed by the face index on width bits,
+ *    appended at the least significant end
+ *
+ *  When a hop no longer fits, or its face index needs more than 16 bits, the label turns into a
+ *  63-bit order-sensitive hash of the path with the hashed flag set. Such a label still tells
+ *  paths apart, but cannot be decoded any more.
+ */
+namespace route_label {
+
+/** \brief label of a path with no hops yet
+ */
+const uint64_t EMPTY = 0;
+
+/** \brief append a hop to \p label
+ *  \param label label received from upstream, or EMPTY
+ *  \param faceIndex index of the face on which the Data arrived
+ */
+uint64_t
+appendHop(uint64_t label, uint64_t faceIndex) noexcept;
+
+/** \return whether the label has overflowed into a path hash
+ */
+bool
+isHashed(uint64_t label) noexcept;
+
+/** \brief decode the face indices of a label, in the order the hops were appended
+ *  \return the face indices, or nullopt if the label is hashed
+ *  \throw std::invalid_argument label is malformed
+ */
+optional<std::vector<uint64_t>>
+decode(uint64_t label);
+
+} // namespace route_label
+
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_ROUTE_LABEL_HPP
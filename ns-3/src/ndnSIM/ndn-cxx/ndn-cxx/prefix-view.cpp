@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/prefix-view.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+size_t
+PrefixView::hash() const noexcept
+{
+  // hash the TLV-TYPE and TLV-VALUE of each component in place; the encoding of the enclosing
+  // Name is not used, so that a prefix hashes the same no matter how long its Name is
+  size_t seed = m_size;
+  for (const auto& component : *this) {
+    boost::hash_combine(seed, component.type());
+    boost::hash_range(seed, component.value_begin(), component.value_end());
+  }
+  return seed;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const PrefixView& prefix)
+{
+  if (prefix.empty()) {
+    return os << "/";
+  }
+
+  for (const auto& component : prefix) {
+    os << "/";
+    component.toUri(os);
+  }
+  return os;
+}
+
+} // namespace ndn
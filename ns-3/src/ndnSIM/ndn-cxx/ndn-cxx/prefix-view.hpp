@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_PREFIX_VIEW_HPP
+#define NDN_PREFIX_VIEW_HPP
+
+#include "ndn-cxx/name.hpp"
+
+namespace ndn {
+
+/** @brief A non-owning view of the first components of a Name.
+ *
+ *  A PrefixView refers to the components of an existing Name in place, so taking a prefix,
+ *  comparing it, or hashing it neither copies components nor allocates. It is meant as a lookup
+ *  key on per-packet paths, where `name.getPrefix(n)` would build a new Name.
+ *
+ *  The viewed Name must outlive the view and must not be modified while the view is in use.
+ */
+class PrefixView
+{
+public:
+  using const_iterator = Name::const_iterator;
+
+  /** @brief Create a view of the first @p nComponents components of @p name
+   *
+   *  If @p nComponents exceeds `name.size()`, the view covers the whole name.
+   */
+  PrefixView(const Name& name, size_t nComponents = Name::npos) noexcept
+    : m_name(&name)
+    , m_size(std::min(nComponents, name.size()))
+  {
+  }
+
+  /** @brief Get the viewed Name
+   */
+  const Name&
+  getName() const noexcept
+  {
+    return *m_name;
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return m_size == 0;
+  }
+
+  /** @brief Get the number of components in the prefix
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_size;
+  }
+
+  /** @brief Get the component at index @p i
+   *  @pre `i < size()`
+   */
+  const name::Component&
+  operator[](size_t i) const
+  {
+    return (*m_name)[i];
+  }
+
+  const_iterator
+  begin() const noexcept
+  {
+    return m_name->begin();
+  }
+
+  const_iterator
+  end() const noexcept
+  {
+    return m_name->begin() + m_size;
+  }
+
+  /** @brief Get a view of the first @p nComponents components of this prefix
+   */
+  PrefixView
+  getPrefix(size_t nComponents) const noexcept
+  {
+    return PrefixView(*m_name, std::min(nComponents, m_size));
+  }
+
+  /** @brief Copy the viewed components into a new Name
+   */
+  Name
+  toName() const
+  {
+    return m_name->getPrefix(static_cast<ssize_t>(m_size));
+  }
+
+  /** @brief Check if this prefix is a prefix of @p other
+   */
+  bool
+  isPrefixOf(const Name& other) const
+  {
+    return m_size <= other.size() &&
+           m_name->compare(0, m_size, other, 0, m_size) == 0;
+  }
+
+  /** @brief Compare with another prefix using NDN canonical ordering
+   *  @sa Name::compare
+   */
+  int
+  compare(const PrefixView& other) const
+  {
+    return m_name->compare(0, m_size, *other.m_name, 0, other.m_size);
+  }
+
+  /** @brief Compute a hash of the viewed components
+   *
+   *  Equal prefixes have equal hashes, regardless of the Names they are taken from.
+   *  The value differs from `std::hash<Name>` of the equivalent Name.
+   */
+  size_t
+  hash() const noexcept;
+
+private: // non-member operators
+  // NOTE: the following "hidden friend" operators are available via
+  //       argument-dependent lookup only and must be defined inline.
+
+  friend bool
+  operator==(const PrefixView& lhs, const PrefixView& rhs)
+  {
+    return lhs.m_size == rhs.m_size && lhs.compare(rhs) == 0;
+  }
+
+  friend bool
+  operator!=(const PrefixView& lhs, const PrefixView& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool
+  operator<(const PrefixView& lhs, const PrefixView& rhs)
+  {
+    return lhs.compare(rhs) < 0;
+  }
+
+  friend bool
+  operator<=(const PrefixView& lhs, const PrefixView& rhs)
+  {
+    return lhs.compare(rhs) <= 0;
+  }
+
+  friend bool
+  operator>(const PrefixView& lhs, const PrefixView& rhs)
+  {
+    return lhs.compare(rhs) > 0;
+  }
+
+  friend bool
+  operator>=(const PrefixView& lhs, const PrefixView& rhs)
+  {
+    return lhs.compare(rhs) >= 0;
+  }
+
+private:
+  const Name* m_name;
+  size_t m_size;
+};
+
+/** @brief Print URI representation of the prefix
+ */
+std::ostream&
+operator<<(std::ostream& os, const PrefixView& prefix);
+
+} // namespace ndn
+
+namespace std {
+
+template<>
+struct hash<ndn::PrefixView>
+{
+  size_t
+  operator()(const ndn::PrefixView& prefix) const noexcept
+  {
+    return prefix.hash();
+  }
+};
+
+} // namespace std
+
+#endif // NDN_PREFIX_VIEW_HPP
@@ -23,45 +23,196 @@
 
 #include <boost/scope_exit.hpp>
 
+#include <deque>
+
 namespace ndn {
 namespace scheduler {
 
 /** \brief Stores internal information about a scheduled event
+ *
+ *  Records are never freed: once an event expires or is canceled, its record is returned to a
+ *  per-thread pool and its generation is incremented, which invalidates every EventId that
+ *  still refers to it.
  */
 class EventInfo : noncopyable
 {
 public:
-  EventInfo(time::nanoseconds after, EventCallback&& cb, uint32_t context)
-    : callback(std::move(cb))
-    , expireTime(time::steady_clock::now() + after)
-    , context(context)
+  bool
+  operator<(const EventInfo& other) const noexcept
+  {
+    return expireTime < other.expireTime ||
+           (expireTime == other.expireTime && seqNo < other.seqNo);
+  }
+
+public:
+  EventCallback callback;
+  time::steady_clock::TimePoint expireTime;
+  uint64_t seqNo = 0; ///< orders events with the same expiration by scheduling time
+  uint64_t generation = 0;
+  Scheduler* scheduler = nullptr;
+  Scheduler::ContextQueue* queue = nullptr;
+  size_t heapIndex = 0;
+};
+
+/** \brief Events of one simulation context, in a binary min-heap
+ */
+class Scheduler::ContextQueue : noncopyable
+{
+public:
+  explicit
+  ContextQueue(uint32_t context)
+    : context(context)
+  {
+  }
+
+  EventInfo&
+  top() const
+  {
+    return *heap.front();
+  }
+
+  void
+  push(EventInfo& info)
+  {
+    info.queue = this;
+    info.heapIndex = heap.size();
+    heap.push_back(&info);
+    siftUp(info.heapIndex);
+  }
+
+  void
+  erase(EventInfo& info)
+  {
+    BOOST_ASSERT(info.queue == this && heap[info.heapIndex] == &info);
+    size_t i = info.heapIndex;
+    EventInfo* last = heap.back();
+    heap.pop_back();
+    info.queue = nullptr;
+    if (last == &info) {
+      return;
+    }
+
+    place(last, i);
+    if (i > 0 && *last < *heap[(i - 1) / 2]) {
+      siftUp(i);
+    }
+    else {
+      siftDown(i);
+    }
+  }
+
+private:
+  void
+  place(EventInfo* info, size_t i)
   {
+    heap[i] = info;
+    info->heapIndex = i;
   }
 
-  NDN_CXX_NODISCARD time::nanoseconds
-  expiresFromNow() const
+  void
+  siftUp(size_t i)
   {
-    return std::max(expireTime - time::steady_clock::now(), 0_ns);
+    EventInfo* info = heap[i];
+    while (i > 0) {
+      size_t parent = (i - 1) / 2;
+      if (!(*info < *heap[parent])) {
+        break;
+      }
+      place(heap[parent], i);
+      i = parent;
+    }
+    place(info, i);
+  }
+
+  void
+  siftDown(size_t i)
+  {
+    EventInfo* info = heap[i];
+    while (true) {
+      size_t child = 2 * i + 1;
+      if (child >= heap.size()) {
+        break;
+      }
+      if (child + 1 < heap.size() && *heap[child + 1] < *heap[child]) {
+        ++child;
+      }
+      if (!(*heap[child] < *info)) {
+        break;
+      }
+      place(heap[child], i);
+      i = child;
+    }
+    place(info, i);
   }
 
 public:
-  EventCallback callback;
-  Scheduler::EventQueue::const_iterator queueIt;
-  time::steady_clock::TimePoint expireTime;
-  bool isExpired = false;
-  uint32_t context = 0;
+  const uint32_t context;
+  std::vector<EventInfo*> heap;
+  ns3::EventId timerEvent;
+  time::steady_clock::TimePoint timerExpireTime;
+  bool isEventExecuting = false;
 };
 
-EventId::EventId(Scheduler& sched, weak_ptr<EventInfo> info)
-  : CancelHandle([&sched, info] { sched.cancelImpl(info.lock()); })
-  , m_info(std::move(info))
+namespace {
+
+class EventInfoPool : noncopyable
+{
+public:
+  EventInfo&
+  allocate()
+  {
+    if (m_free.empty()) {
+      m_records.emplace_back();
+      return m_records.back();
+    }
+
+    EventInfo* info = m_free.back();
+    m_free.pop_back();
+    return *info;
+  }
+
+  void
+  release(EventInfo& info)
+  {
+    ++info.generation;
+    info.callback = nullptr;
+    info.scheduler = nullptr;
+    info.queue = nullptr;
+    m_free.push_back(&info);
+  }
+
+private:
+  std::deque<EventInfo> m_records;
+  std::vector<EventInfo*> m_free;
+};
+
+EventInfoPool&
+getEventInfoPool()
+{
+  // One pool per thread, so that the threads of a multithreaded ns-3 simulation never share
+  // the free list; a record released by another thread joins the free list of that thread.
+  // Intentionally leaked, so that EventIds destructed during static destruction or at thread
+  // exit remain safe.
+  static thread_local auto pool = new EventInfoPool;
+  return *pool;
+}
+
+} // namespace
+
+EventId::EventId(EventInfo& info) noexcept
+  : CancelHandle([info = &info, generation = info.generation] {
+      if (info->generation == generation) {
+        info->scheduler->cancelImpl(*info);
+      }
+    })
+  , m_info(&info)
+  , m_generation(info.generation)
 {
 }
 
 EventId::operator bool() const noexcept
 {
-  auto sp = m_info.lock();
-  return sp != nullptr && !sp->isExpired;
+  return m_info != nullptr && m_info->generation == m_generation;
 }
 
 void
@@ -73,14 +224,7 @@ EventId::reset() noexcept
 std::ostream&
 operator<<(std::ostream& os, const EventId& eventId)
 {
-  return os << eventId.m_info.lock();
-}
-
-bool
-Scheduler::EventQueueCompare::operator()(const shared_ptr<EventInfo>& a,
-                                         const shared_ptr<EventInfo>& b) const noexcept
-{
-  return a->expireTime < b->expireTime;
+  return os << static_cast<const void*>(eventId ? eventId.m_info : nullptr);
 }
 
 Scheduler::Scheduler(DummyIoService& ioService)
@@ -97,86 +241,114 @@ Scheduler::schedule(time::nanoseconds after, EventCallback callback)
 {
   BOOST_ASSERT(callback != nullptr);
 
-  auto i = m_queue.insert(make_shared<EventInfo>(after, std::move(callback), ns3::Simulator::GetContext()));
-  (*i)->queueIt = i;
+  EventInfo& info = getEventInfoPool().allocate();
+  info.callback = std::move(callback);
+  info.expireTime = time::steady_clock::now() + after;
+  info.seqNo = m_nextSeqNo++;
+  info.scheduler = this;
+
+  ContextQueue& queue = getQueue(ns3::Simulator::GetContext());
+  queue.push(info);
 
-  if (!m_isEventExecuting && i == m_queue.begin()) {
+  if (!queue.isEventExecuting && &queue.top() == &info) {
     // the new event is the first one to expire
-    this->scheduleNext();
+    this->scheduleNext(queue);
   }
 
-  return EventId(*this, *i);
+  return EventId(info);
 }
 
 void
-Scheduler::cancelImpl(const shared_ptr<EventInfo>& info)
+Scheduler::cancelImpl(EventInfo& info)
 {
-  if (info == nullptr || info->isExpired) {
-    return;
-  }
+  // The ns-3 timer is left armed: if it fires before the next event is due, it rearms itself.
+  info.queue->erase(info);
+  getEventInfoPool().release(info);
+}
 
-  if (m_timerEvent) {
-    if (!m_timerEvent->IsExpired()) {
-      ns3::Simulator::Remove(*m_timerEvent);
+void
+Scheduler::cancelAllEvents()
+{
+  auto cancelQueue = [] (ContextQueue* queue) {
+    if (queue == nullptr) {
+      return;
     }
-    m_timerEvent.reset();
-  }
-  m_queue.erase(info->queueIt);
+    for (EventInfo* info : queue->heap) {
+      getEventInfoPool().release(*info);
+    }
+    queue->heap.clear();
+    queue->timerEvent.Cancel();
+  };
 
-  if (!m_isEventExecuting) {
-    this->scheduleNext();
+  for (const auto& queue : m_queues) {
+    cancelQueue(queue.get());
   }
+  cancelQueue(m_noContextQueue.get());
 }
 
-void
-Scheduler::cancelAllEvents()
+Scheduler::ContextQueue&
+Scheduler::getQueue(uint32_t context)
 {
-  m_queue.clear();
-  if (m_timerEvent) {
-    if (!m_timerEvent->IsExpired()) {
-      ns3::Simulator::Remove(*m_timerEvent);
+  if (context == ns3::Simulator::NO_CONTEXT) {
+    if (m_noContextQueue == nullptr) {
+      m_noContextQueue = make_unique<ContextQueue>(context);
     }
-    m_timerEvent.reset();
+    return *m_noContextQueue;
+  }
+
+  if (context >= m_queues.size()) {
+    m_queues.resize(context + 1);
   }
+  if (m_queues[context] == nullptr) {
+    m_queues[context] = make_unique<ContextQueue>(context);
+  }
+  return *m_queues[context];
 }
 
 void
-Scheduler::scheduleNext()
+Scheduler::scheduleNext(ContextQueue& queue)
 {
-  if (!m_queue.empty()) {
-    m_timerEvent = ns3::Simulator::Schedule(ns3::NanoSeconds((*m_queue.begin())->expiresFromNow().count()),
-                                            &Scheduler::executeEvent, this);
+  if (queue.heap.empty()) {
+    return;
+  }
+
+  auto expireTime = queue.top().expireTime;
+  if (queue.timerEvent.IsRunning() && queue.timerExpireTime <= expireTime) {
+    return;
   }
+
+  queue.timerEvent.Cancel();
+  queue.timerExpireTime = expireTime;
+  auto delay = std::max(expireTime - time::steady_clock::now(), time::steady_clock::duration::zero());
+  // Events are only added to the queue of the current context, so the ns-3 event inherits it
+  BOOST_ASSERT(ns3::Simulator::GetContext() == queue.context);
+  queue.timerEvent = ns3::Simulator::Schedule(ns3::NanoSeconds(time::nanoseconds(delay).count()),
+                                              &Scheduler::executeEvents, this, &queue);
 }
 
 void
-Scheduler::executeEvent()
+Scheduler::executeEvents(ContextQueue* queue)
 {
-  m_isEventExecuting = true;
+  queue->isEventExecuting = true;
 
-  m_timerEvent.reset();
-  BOOST_SCOPE_EXIT(this_) {
-    this_->m_isEventExecuting = false;
-    this_->scheduleNext();
+  queue->timerEvent = ns3::EventId();
+  BOOST_SCOPE_EXIT(this_, queue) {
+    queue->isEventExecuting = false;
+    this_->scheduleNext(*queue);
   } BOOST_SCOPE_EXIT_END
 
   // process all expired events
   auto now = time::steady_clock::now();
-  while (!m_queue.empty()) {
-    auto head = m_queue.begin();
-    shared_ptr<EventInfo> info = *head;
-    if (info->expireTime > now) {
+  while (!queue->heap.empty()) {
+    EventInfo& info = queue->top();
+    if (info.expireTime > now) {
       break;
     }
 
-    m_queue.erase(head);
-    info->isExpired = true;
-    if (ns3::Simulator::GetContext() == info->context) {
-      info->callback();
-    }
-    else {
-      ns3::Simulator::ScheduleWithContext(info->context, ns3::Seconds(0), ns3::MakeEvent(info->callback));
-    }
+    queue->erase(info);
+    EventCallback callback = std::move(info.callback);
+    getEventInfoPool().release(info);
+    callback();
   }
 }
 
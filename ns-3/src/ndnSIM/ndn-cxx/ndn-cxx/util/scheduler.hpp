@@ -28,7 +28,7 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
+#include <vector>
 
 namespace ndn {
 
@@ -86,8 +86,7 @@ private:
   operator==(const EventId& lhs, const EventId& rhs) noexcept
   {
     return (!lhs && !rhs) ||
-        (!lhs.m_info.owner_before(rhs.m_info) &&
-         !rhs.m_info.owner_before(lhs.m_info));
+        (lhs.m_info == rhs.m_info && lhs.m_generation == rhs.m_generation);
   }
 
   friend bool
@@ -97,10 +96,12 @@ private:
   }
 
 private:
-  EventId(Scheduler& sched, weak_ptr<EventInfo> info);
+  explicit
+  EventId(EventInfo& info) noexcept;
 
 private:
-  weak_ptr<EventInfo> m_info;
+  EventInfo* m_info = nullptr;
+  uint64_t m_generation = 0; ///< generation of m_info when the event was scheduled
 
   friend class Scheduler;
   friend std::ostream& operator<<(std::ostream& os, const EventId& eventId);
@@ -128,6 +129,11 @@ operator<<(std::ostream& os, const EventId& eventId);
 using ScopedEventId = detail::ScopedCancelHandle<EventId>;
 
 /** \brief Generic time-based scheduler
+ *
+ *  Events are kept per simulation context (i.e., per node), each context having its own binary
+ *  heap and a single ns-3 event armed, in that context, for the earliest expiration. An event
+ *  therefore runs in the context it was scheduled from, without hopping through another node.
+ *  Event records are pooled and reused, so scheduling does not allocate in steady state.
  */
 class Scheduler : noncopyable
 {
@@ -149,32 +155,32 @@ public:
   cancelAllEvents();
 
 private:
+  class ContextQueue;
+
   void
-  cancelImpl(const shared_ptr<EventInfo>& info);
+  cancelImpl(EventInfo& info);
+
+  /** \return event queue of the simulation context \p context, created on first use
+   */
+  ContextQueue&
+  getQueue(uint32_t context);
 
-  /** \brief Schedule the next event on the internal timer
+  /** \brief Arm the ns-3 timer of \p queue for its earliest event
+   *
+   *  The timer is only rearmed if it would otherwise fire too late.
    */
   void
-  scheduleNext();
+  scheduleNext(ContextQueue& queue);
 
-  /** \brief Execute expired events
+  /** \brief Execute expired events of \p queue
    */
   void
-  executeEvent();
+  executeEvents(ContextQueue* queue);
 
 private:
-  class EventQueueCompare
-  {
-  public:
-    bool
-    operator()(const shared_ptr<EventInfo>& a, const shared_ptr<EventInfo>& b) const noexcept;
-  };
-
-  using EventQueue = std::multiset<shared_ptr<EventInfo>, EventQueueCompare>;
-  EventQueue m_queue;
-
-  bool m_isEventExecuting = false;
-  ndn::optional<ns3::EventId> m_timerEvent;
+  std::vector<unique_ptr<ContextQueue>> m_queues; ///< indexed by simulation context
+  unique_ptr<ContextQueue> m_noContextQueue; ///< events scheduled outside of any node
+  uint64_t m_nextSeqNo = 0;
 
   friend EventId;
   friend EventInfo;
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/route-label.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <limits>
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+using namespace route_label;
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_AUTO_TEST_SUITE(TestRouteLabel)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  BOOST_CHECK(!isHashed(EMPTY));
+  BOOST_REQUIRE(decode(EMPTY));
+  BOOST_CHECK(decode(EMPTY)->empty());
+}
+
+BOOST_AUTO_TEST_CASE(AppendDecode)
+{
+  uint64_t label = appendHop(EMPTY, 3);
+  label = appendHop(label, 12);
+  label = appendHop(label, 0);
+
+  // each hop is a 4-bit width prefix and an index just as wide as needed: 2, 4 and 1 bits
+  BOOST_CHECK(!isHashed(label));
+  BOOST_CHECK_EQUAL(label >> 57, 19);
+  std::vector<uint64_t> expected{3, 12, 0};
+  auto hops = decode(label);
+  BOOST_REQUIRE(hops);
+  BOOST_CHECK_EQUAL_COLLECTIONS(hops->begin(), hops->end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(NoAmbiguity)
+{
+  // the old decimal encoding mapped both paths to 111
+  uint64_t a = appendHop(appendHop(EMPTY, 11), 1);
+  uint64_t b = appendHop(appendHop(appendHop(EMPTY, 1), 1), 1);
+  BOOST_CHECK_NE(a, b);
+
+  // order matters
+  BOOST_CHECK_NE(appendHop(appendHop(EMPTY, 1), 2),
+                 appendHop(appendHop(EMPTY, 2), 1));
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  // a 3-bit index costs 7 bits per hop, so 8 hops fit in 57 bits
+  uint64_t label = EMPTY;
+  for (int i = 0; i < 8; ++i) {
+    label = appendHop(label, 4 + i % 4);
+  }
+  BOOST_CHECK(!isHashed(label));
+  BOOST_REQUIRE(decode(label));
+  BOOST_CHECK_EQUAL(decode(label)->size(), 8);
+
+  uint64_t hashed = appendHop(label, 1);
+  BOOST_CHECK(isHashed(hashed));
+  BOOST_CHECK(!decode(hashed));
+
+  // hashed labels keep telling paths apart, long after 19 hops
+  uint64_t other = appendHop(label, 2);
+  for (int i = 0; i < 500; ++i) {
+    uint64_t nextHashed = appendHop(hashed, 5);
+    uint64_t nextOther = appendHop(other, 5);
+    BOOST_CHECK(isHashed(nextHashed));
+    BOOST_CHECK_NE(nextHashed, nextOther);
+    hashed = nextHashed;
+    other = nextOther;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LargeFaceIndex)
+{
+  uint64_t widest = appendHop(EMPTY, (1 << 16) - 1);
+  BOOST_CHECK(!isHashed(widest));
+  BOOST_REQUIRE(decode(widest));
+  BOOST_CHECK_EQUAL(decode(widest)->front(), (1 << 16) - 1);
+
+  // a face index beyond 16 bits, e.g. a large FaceId, falls back to the hashed encoding
+  uint64_t label = appendHop(EMPTY, 3);
+  uint64_t hashed = appendHop(label, 1 << 16);
+  BOOST_CHECK(isHashed(hashed));
+  BOOST_CHECK(!decode(hashed));
+  BOOST_CHECK_NE(hashed, appendHop(label, (1 << 16) + 1));
+  BOOST_CHECK_NE(hashed, appendHop(appendHop(EMPTY, 4), 1 << 16));
+
+  // later hops keep the label hashed
+  BOOST_CHECK(isHashed(appendHop(hashed, 1)));
+  BOOST_CHECK(isHashed(appendHop(EMPTY, std::numeric_limits<uint64_t>::max())));
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  // length says 3 bits, which cannot hold a width prefix and an index
+  BOOST_CHECK_THROW(decode((uint64_t(3) << 57) | 0x1), std::invalid_argument);
+  // payload bits beyond the declared length
+  BOOST_CHECK_THROW(decode(0x1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRouteLabel
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
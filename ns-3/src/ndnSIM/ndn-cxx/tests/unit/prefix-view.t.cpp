@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/prefix-view.hpp"
+
+#include "tests/boost-test.hpp"
+#include <boost/lexical_cast.hpp>
+#include <unordered_set>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestPrefixView)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  Name name("/A/B/C");
+
+  PrefixView whole(name);
+  BOOST_CHECK_EQUAL(&whole.getName(), &name);
+  BOOST_CHECK_EQUAL(whole.size(), 3);
+  BOOST_CHECK_EQUAL(whole.toName(), name);
+
+  PrefixView prefix(name, 2);
+  BOOST_CHECK_EQUAL(prefix.size(), 2);
+  BOOST_CHECK_EQUAL(prefix[1], name::Component("B"));
+  BOOST_CHECK_EQUAL(prefix.end() - prefix.begin(), 2);
+  BOOST_CHECK_EQUAL(prefix.toName(), "/A/B");
+  BOOST_CHECK_EQUAL(prefix.getPrefix(1).toName(), "/A");
+  BOOST_CHECK_EQUAL(prefix.getPrefix(5).size(), 2);
+
+  PrefixView clamped(name, 10);
+  BOOST_CHECK_EQUAL(clamped.size(), 3);
+
+  PrefixView empty(name, 0);
+  BOOST_CHECK(empty.empty());
+  BOOST_CHECK_EQUAL(empty.toName(), Name());
+}
+
+BOOST_AUTO_TEST_CASE(IsPrefixOf)
+{
+  Name name("/A/B/C");
+  BOOST_CHECK(PrefixView(name, 0).isPrefixOf("/"));
+  BOOST_CHECK(PrefixView(name, 0).isPrefixOf("/X"));
+  BOOST_CHECK(PrefixView(name, 2).isPrefixOf("/A/B"));
+  BOOST_CHECK(PrefixView(name, 2).isPrefixOf("/A/B/D"));
+  BOOST_CHECK(!PrefixView(name, 2).isPrefixOf("/A"));
+  BOOST_CHECK(!PrefixView(name, 2).isPrefixOf("/A/C"));
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  Name abc("/A/B/C");
+  Name abd("/A/B/D");
+  Name ab("/A/B");
+
+  BOOST_CHECK_EQUAL(PrefixView(abc, 2), PrefixView(abd, 2));
+  BOOST_CHECK_EQUAL(PrefixView(abc, 2), PrefixView(ab));
+  BOOST_CHECK_NE(PrefixView(abc, 2), PrefixView(abc, 1));
+  BOOST_CHECK_NE(PrefixView(abc), PrefixView(abd));
+
+  BOOST_CHECK_LT(PrefixView(abc, 1), PrefixView(abc, 2));
+  BOOST_CHECK_LT(PrefixView(abc), PrefixView(abd));
+  BOOST_CHECK_LE(PrefixView(abc, 2), PrefixView(abd, 2));
+  BOOST_CHECK_GT(PrefixView(abd), PrefixView(abc));
+  BOOST_CHECK_GE(PrefixView(abd, 2), PrefixView(ab));
+
+  // same ordering as the equivalent Names
+  BOOST_CHECK_EQUAL(PrefixView(abc, 2).compare(PrefixView(abd)), Name("/A/B").compare(abd));
+}
+
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  Name abc("/A/B/C");
+  Name abd("/A/B/D");
+  Name ab("/A/B");
+
+  std::hash<PrefixView> hash;
+  BOOST_CHECK_EQUAL(hash(PrefixView(abc, 2)), hash(PrefixView(abd, 2)));
+  BOOST_CHECK_EQUAL(hash(PrefixView(abc, 2)), hash(PrefixView(ab)));
+  BOOST_CHECK_NE(hash(PrefixView(abc)), hash(PrefixView(abd)));
+  BOOST_CHECK_NE(hash(PrefixView(abc, 1)), hash(PrefixView(abc, 2)));
+  // component type is part of the hash
+  BOOST_CHECK_NE(hash(PrefixView(Name("/8=A"))), hash(PrefixView(Name("/32=A"))));
+
+  std::unordered_set<PrefixView> set;
+  set.insert(PrefixView(abc, 2));
+  BOOST_CHECK_EQUAL(set.count(PrefixView(abd, 2)), 1);
+  BOOST_CHECK_EQUAL(set.count(PrefixView(abd)), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  Name name("/A/B/C");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(PrefixView(name, 2)), "/A/B");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(PrefixView(name, 0)), "/");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPrefixView
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,375 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2026  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-omccrf.hpp"
+
+#include "../tests-common.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumerOmccrf, CleanupFixture)
+
+BOOST_AUTO_TEST_SUITE(SlidingMinMaxTest)
+
+BOOST_AUTO_TEST_CASE(WindowExpiry)
+{
+  SlidingMinMax window(3);
+  window.push(5);
+  window.push(1);
+  window.push(4);
+  BOOST_CHECK_EQUAL(window.count(), 3);
+  BOOST_CHECK_EQUAL(window.min(), 1);
+  BOOST_CHECK_EQUAL(window.max(), 5);
+
+  // the maximum leaves the window
+  window.push(2);
+  BOOST_CHECK_EQUAL(window.min(), 1);
+  BOOST_CHECK_EQUAL(window.max(), 4);
+
+  // the minimum leaves the window
+  window.push(3);
+  BOOST_CHECK_EQUAL(window.min(), 2);
+  BOOST_CHECK_EQUAL(window.max(), 4);
+
+  window.push(6);
+  BOOST_CHECK_EQUAL(window.min(), 2);
+  BOOST_CHECK_EQUAL(window.max(), 6);
+
+  window.push(7);
+  BOOST_CHECK_EQUAL(window.count(), 7);
+  BOOST_CHECK_EQUAL(window.min(), 3);
+  BOOST_CHECK_EQUAL(window.max(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(EqualValues)
+{
+  SlidingMinMax window(2);
+  window.push(5);
+  window.push(5);
+  BOOST_CHECK_EQUAL(window.min(), 5);
+  BOOST_CHECK_EQUAL(window.max(), 5);
+
+  // the first 5 leaves, the second one is still the maximum
+  window.push(1);
+  BOOST_CHECK_EQUAL(window.min(), 1);
+  BOOST_CHECK_EQUAL(window.max(), 5);
+
+  window.push(1);
+  BOOST_CHECK_EQUAL(window.min(), 1);
+  BOOST_CHECK_EQUAL(window.max(), 1);
+
+  window.push(1);
+  BOOST_CHECK_EQUAL(window.min(), 1);
+  BOOST_CHECK_EQUAL(window.max(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SingleSample)
+{
+  SlidingMinMax window(1);
+  for (double sample : {3.0, 1.0, 1.0, 2.0}) {
+    window.push(sample);
+    BOOST_CHECK_EQUAL(window.min(), sample);
+    BOOST_CHECK_EQUAL(window.max(), sample);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Clear)
+{
+  SlidingMinMax window(3);
+  window.push(1);
+  window.push(9);
+  window.clear();
+  BOOST_CHECK_EQUAL(window.count(), 0);
+
+  window.push(4);
+  BOOST_CHECK_EQUAL(window.count(), 1);
+  BOOST_CHECK_EQUAL(window.min(), 4);
+  BOOST_CHECK_EQUAL(window.max(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(CompareWithScan)
+{
+  // few distinct values, so that many samples are equal and evictions hit the queue fronts often
+  const size_t capacity = 5;
+  SlidingMinMax window(capacity);
+  std::deque<double> samples;
+  uint32_t state = 1;
+  for (int i = 0; i < 1000; ++i) {
+    state = state * 1103515245 + 12345;
+    double sample = (state >> 16) % 4;
+
+    window.push(sample);
+    samples.push_back(sample);
+    if (samples.size() > capacity) {
+      samples.pop_front();
+    }
+    BOOST_CHECK_EQUAL(window.min(), *std::min_element(samples.begin(), samples.end()));
+    BOOST_CHECK_EQUAL(window.max(), *std::max_element(samples.begin(), samples.end()));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // SlidingMinMaxTest
+
+BOOST_AUTO_TEST_SUITE(InFlightRingTest)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  InFlightRing ring(4);
+  ring.insert(5, Seconds(1));
+  BOOST_CHECK_EQUAL(ring.size(), 1);
+  BOOST_REQUIRE(ring.find(5) != nullptr);
+  BOOST_CHECK_EQUAL(ring.find(5)->sendTime, Seconds(1));
+  BOOST_CHECK_EQUAL(ring.find(5)->nRetx, 0);
+  BOOST_CHECK(ring.find(1) == nullptr); // same slot, other sequence number
+
+  // retransmission
+  ring.insert(5, Seconds(2));
+  BOOST_CHECK_EQUAL(ring.size(), 1);
+  BOOST_CHECK_EQUAL(ring.find(5)->sendTime, Seconds(2));
+  BOOST_CHECK_EQUAL(ring.find(5)->nRetx, 1);
+
+  ring.erase(5);
+  BOOST_CHECK_EQUAL(ring.size(), 0);
+  BOOST_CHECK(ring.find(5) == nullptr);
+  ring.erase(5);
+  BOOST_CHECK_EQUAL(ring.size(), 0);
+
+  // the released slot still counts a later retransmission
+  ring.insert(5, Seconds(3));
+  BOOST_CHECK_EQUAL(ring.find(5)->nRetx, 2);
+
+  // until another sequence number reuses it
+  ring.erase(5);
+  ring.insert(9, Seconds(4));
+  ring.erase(9);
+  ring.insert(5, Seconds(5));
+  BOOST_CHECK_EQUAL(ring.find(5)->nRetx, 0);
+}
+
+BOOST_AUTO_TEST_CASE(EraseInTheMiddle)
+{
+  InFlightRing ring(8);
+  for (uint32_t seq = 10; seq < 15; ++seq) {
+    ring.insert(seq, Seconds(seq));
+  }
+
+  ring.erase(12);
+  BOOST_CHECK_EQUAL(ring.size(), 4);
+  BOOST_CHECK(ring.find(12) == nullptr);
+  for (uint32_t seq : {10, 11, 13, 14}) {
+    BOOST_REQUIRE(ring.find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(ring.find(seq)->sendTime, Seconds(seq));
+  }
+
+  // a new sequence number may take the released slot without growing
+  ring.insert(20, Seconds(20));
+  BOOST_CHECK_EQUAL(ring.size(), 5);
+  BOOST_CHECK_EQUAL(ring.find(20)->nRetx, 0);
+  for (uint32_t seq : {10, 11, 13, 14, 20}) {
+    BOOST_CHECK(ring.find(seq) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GrowWhileWrapped)
+{
+  // 6..9 occupy slots 2, 3, 0 and 1, so the window wraps around the end of the ring
+  InFlightRing ring(4);
+  for (uint32_t seq = 6; seq < 10; ++seq) {
+    ring.insert(seq, Seconds(seq));
+  }
+  ring.insert(7, Seconds(17)); // retransmission
+
+  // 10 lands on the slot of 6, which is still in flight
+  ring.insert(10, Seconds(10));
+  BOOST_CHECK_EQUAL(ring.size(), 5);
+  for (uint32_t seq = 6; seq < 11; ++seq) {
+    BOOST_REQUIRE(ring.find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(ring.find(seq)->seq, seq);
+  }
+  BOOST_CHECK_EQUAL(ring.find(6)->sendTime, Seconds(6));
+  BOOST_CHECK_EQUAL(ring.find(7)->sendTime, Seconds(17));
+  BOOST_CHECK_EQUAL(ring.find(7)->nRetx, 1);
+
+  // 0 and 16 collide at 4, 8 and 16 slots, so growing has to double more than once
+  InFlightRing sparse(4);
+  sparse.insert(0, Seconds(0));
+  sparse.insert(16, Seconds(16));
+  BOOST_CHECK_EQUAL(sparse.size(), 2);
+  BOOST_CHECK_EQUAL(sparse.find(0)->sendTime, Seconds(0));
+  BOOST_CHECK_EQUAL(sparse.find(16)->sendTime, Seconds(16));
+}
+
+BOOST_AUTO_TEST_CASE(Reserve)
+{
+  InFlightRing ring(4);
+  for (uint32_t seq = 0; seq < 3; ++seq) {
+    ring.insert(seq, Seconds(seq));
+  }
+  ring.reserve(100);
+  for (uint32_t seq = 3; seq < 100; ++seq) {
+    ring.insert(seq, Seconds(seq));
+  }
+  BOOST_CHECK_EQUAL(ring.size(), 100);
+  for (uint32_t seq = 0; seq < 100; ++seq) {
+    BOOST_REQUIRE(ring.find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(ring.find(seq)->sendTime, Seconds(seq));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SequenceWraparound)
+{
+  InFlightRing ring(4);
+  const uint32_t last = std::numeric_limits<uint32_t>::max();
+  ring.insert(last - 1, Seconds(1));
+  ring.insert(last, Seconds(2));
+  ring.insert(0, Seconds(3));
+  ring.insert(1, Seconds(4));
+  BOOST_CHECK_EQUAL(ring.size(), 4);
+
+  // 2 lands on the slot of last - 1, growing the ring
+  ring.insert(2, Seconds(5));
+  BOOST_CHECK_EQUAL(ring.size(), 5);
+  BOOST_CHECK_EQUAL(ring.find(last - 1)->sendTime, Seconds(1));
+  BOOST_CHECK_EQUAL(ring.find(last)->sendTime, Seconds(2));
+  BOOST_CHECK_EQUAL(ring.find(0)->sendTime, Seconds(3));
+  BOOST_CHECK_EQUAL(ring.find(1)->sendTime, Seconds(4));
+  BOOST_CHECK_EQUAL(ring.find(2)->sendTime, Seconds(5));
+
+  ring.erase(last);
+  ring.erase(0);
+  BOOST_CHECK(ring.find(last) == nullptr);
+  BOOST_CHECK(ring.find(0) == nullptr);
+  BOOST_CHECK_EQUAL(ring.size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // InFlightRingTest
+
+BOOST_AUTO_TEST_SUITE(RouteRegistryTest)
+
+BOOST_AUTO_TEST_CASE(Touch)
+{
+  RouteRegistry routes;
+  BOOST_CHECK_EQUAL(routes.size(), 0);
+
+  RouteMonitor* a = &routes.touch(1, Seconds(1), 30);
+  BOOST_CHECK_EQUAL(routes.size(), 1);
+  BOOST_CHECK_EQUAL(&routes.touch(1, Seconds(2), 30), a);
+  BOOST_CHECK_EQUAL(routes.size(), 1);
+
+  RouteMonitor* b = &routes.touch(2, Seconds(2), 30);
+  BOOST_CHECK_EQUAL(routes.size(), 2);
+  BOOST_CHECK_NE(b, &routes.touch(1, Seconds(3), 30));
+  BOOST_CHECK_EQUAL(&routes.touch(2, Seconds(3), 30), b);
+  BOOST_CHECK_EQUAL(routes.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  RouteRegistry routes;
+  routes.touch(1, Seconds(1), 30);
+  routes.touch(2, Seconds(2), 30);
+  routes.touch(3, Seconds(3), 30);
+  routes.touch(1, Seconds(4), 30);
+
+  // route 2 delivered Data exactly at the cutoff and is kept
+  routes.expire(Seconds(2));
+  BOOST_CHECK_EQUAL(routes.size(), 3);
+
+  routes.expire(Seconds(3.5));
+  BOOST_CHECK_EQUAL(routes.size(), 1);
+  routes.touch(1, Seconds(5), 30);
+  BOOST_CHECK_EQUAL(routes.size(), 1);
+
+  // an expired route comes back as a new one, in a recycled slot
+  routes.touch(2, Seconds(5), 30);
+  BOOST_CHECK_EQUAL(routes.size(), 2);
+
+  routes.expire(Seconds(10));
+  BOOST_CHECK_EQUAL(routes.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ExpireInProbeChain)
+{
+  // four labels with the same home bucket in the initial index, so that they form one probe
+  // chain; the registry stays below half load and does not rehash
+  const uint64_t mask = RouteRegistry::INITIAL_BUCKETS - 1;
+  std::vector<uint64_t> labels;
+  for (uint64_t label = 1; labels.size() < 4; ++label) {
+    if ((RouteRegistry::hashLabel(label) & mask) == (RouteRegistry::hashLabel(1) & mask)) {
+      labels.push_back(label);
+    }
+  }
+
+  RouteRegistry routes;
+  for (size_t i = 0; i < labels.size(); ++i) {
+    routes.touch(labels[i], Seconds(i % 2 == 0 ? 5 : 1), 30);
+  }
+  BOOST_CHECK_EQUAL(routes.size(), 4);
+
+  // the second and fourth labels leave holes in the middle and at the end of the chain
+  routes.expire(Seconds(2));
+  BOOST_CHECK_EQUAL(routes.size(), 2);
+
+  // the third label has been shifted back and is still found
+  routes.touch(labels[0], Seconds(6), 30);
+  routes.touch(labels[2], Seconds(6), 30);
+  BOOST_CHECK_EQUAL(routes.size(), 2);
+
+  routes.touch(labels[1], Seconds(6), 30);
+  routes.touch(labels[3], Seconds(6), 30);
+  BOOST_CHECK_EQUAL(routes.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(ManyRoutes)
+{
+  // enough routes to rehash several times and build probe chains that wrap around the index
+  RouteRegistry routes;
+  for (uint64_t label = 0; label < 1000; ++label) {
+    routes.touch(label, Seconds(label % 3 == 0 ? 1 : 5), 30);
+  }
+  BOOST_CHECK_EQUAL(routes.size(), 1000);
+
+  routes.expire(Seconds(2));
+  BOOST_CHECK_EQUAL(routes.size(), 666);
+
+  for (uint64_t label = 0; label < 1000; ++label) {
+    if (label % 3 != 0) {
+      routes.touch(label, Seconds(6), 30);
+    }
+  }
+  BOOST_CHECK_EQUAL(routes.size(), 666);
+
+  for (uint64_t label = 0; label < 1000; label += 3) {
+    routes.touch(label, Seconds(6), 30);
+  }
+  BOOST_CHECK_EQUAL(routes.size(), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RouteRegistryTest
+
+BOOST_AUTO_TEST_SUITE_END() // AppsConsumerOmccrf
+
+} // namespace ndn
+} // namespace ns3
@@ -54,18 +54,19 @@ BOOST_AUTO_TEST_CASE(TwoNodeTopology)
   Simulator::Schedule(Seconds(5.1), ndn::LinkControlHelper::FailLink, getNode("1"), getNode("2"));
   Simulator::Schedule(Seconds(10.1), ndn::LinkControlHelper::UpLink, getNode("1"), getNode("2"));
 
+  // Interests sent at 0s..5s are all satisfied before the link goes down
   nfd::getScheduler().schedule(time::milliseconds(5200), [&] {
-      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 5);
-      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 5);
+      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 6);
+      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 6);
     });
 
   nfd::getScheduler().schedule(time::milliseconds(10200), [&] {
-      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 5);
-      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 5);
+      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 6);
+      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 6);
     });
   nfd::getScheduler().schedule(time::milliseconds(15100), [&] {
-      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 10);
-      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 10);
+      BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 11);
+      BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 11);
     });
 
   Simulator::Stop(Seconds(15.2));
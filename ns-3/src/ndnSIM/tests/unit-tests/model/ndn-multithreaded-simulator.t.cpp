@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2026  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "../tests-common.hpp"
+
+#include "ns3/point-to-point-module.h"
+#include "ns3/multithreaded-simulator-impl.h"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnMultithreadedSimulator, CleanupFixture)
+
+// Runs a consumer and a producer at the ends of a 4-node chain, whose middle link connects
+// system ids 0 and 1, and returns the forwarder counters of every node
+static std::vector<uint64_t>
+runChain(const std::string& simulatorImpl)
+{
+  GlobalValue::Bind("SimulatorImplementationType", StringValue(simulatorImpl));
+  Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(2));
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < 4; ++i) {
+    nodes.Add(CreateObject<Node>(i / 2));
+  }
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i + 1 < nodes.GetN(); ++i) {
+    p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+  }
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+  for (uint32_t i = 0; i + 1 < nodes.GetN(); ++i) {
+    FibHelper::AddRoute(nodes.Get(i), "/prefix", nodes.Get(i + 1), 1);
+  }
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("100"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(5));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(3));
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+
+  std::vector<uint64_t> counters;
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    const nfd::ForwarderCounters& nodeCounters =
+      L3Protocol::getL3Protocol(nodes.Get(i))->getForwarder()->getCounters();
+    counters.push_back(nodeCounters.nInInterests);
+    counters.push_back(nodeCounters.nOutInterests);
+    counters.push_back(nodeCounters.nInData);
+    counters.push_back(nodeCounters.nOutData);
+  }
+
+  Simulator::Destroy();
+  GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+  return counters;
+}
+
+BOOST_AUTO_TEST_CASE(SameResultAsDefault)
+{
+  std::vector<uint64_t> expected = runChain("ns3::DefaultSimulatorImpl");
+  // the consumer got its Data packets across the partitions
+  BOOST_CHECK_GT(expected[2], 400);
+
+  std::vector<uint64_t> actual = runChain("ns3::MultithreadedSimulatorImpl");
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+// Runs a consumer and a producer on a single node, with no channel at all, and returns
+// the forwarder counters of the node
+static std::vector<uint64_t>
+runSingleNode(const std::string& simulatorImpl)
+{
+  GlobalValue::Bind("SimulatorImplementationType", StringValue(simulatorImpl));
+
+  Ptr<Node> node = CreateObject<Node>();
+
+  StackHelper ndnHelper;
+  ndnHelper.Install(node);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("100"));
+  consumerHelper.Install(node).Stop(Seconds(5));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.Install(node);
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+
+  const nfd::ForwarderCounters& counters = L3Protocol::getL3Protocol(node)->getForwarder()->getCounters();
+  std::vector<uint64_t> result{counters.nInInterests, counters.nOutInterests,
+                               counters.nInData, counters.nOutData};
+
+  Simulator::Destroy();
+  GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(NoChannel)
+{
+  std::vector<uint64_t> expected = runSingleNode("ns3::DefaultSimulatorImpl");
+  BOOST_CHECK_GT(expected[2], 400);
+
+  // with no channel to derive a lookahead from, the partition runs to the next main event
+  std::vector<uint64_t> actual = runSingleNode("ns3::MultithreadedSimulatorImpl");
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2026  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "ns3/ndnSIM/utils/ndn-time.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::scheduler::EventId;
+using ::ndn::scheduler::Scheduler;
+using ::ndn::scheduler::ScopedEventId;
+using namespace ::ndn::time_literals;
+
+class NdnCxxSchedulerFixture : public CleanupFixture
+{
+public:
+  NdnCxxSchedulerFixture()
+    : scheduler(io)
+  {
+    ::ndn::time::setCustomClocks(make_shared<time::CustomSteadyClock>(),
+                                 make_shared<time::CustomSystemClock>());
+  }
+
+  /** \brief run \p f in the simulation context \p context after \p delay
+   */
+  static void
+  runInContext(uint32_t context, Time delay, std::function<void()> f)
+  {
+    Simulator::ScheduleWithContext(context, delay, MakeEvent(std::move(f)));
+  }
+
+protected:
+  ::ndn::DummyIoService io;
+  Scheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxScheduler, NdnCxxSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(PerContextEvents)
+{
+  std::vector<std::pair<uint32_t, Time>> fired;
+  auto record = [&] { fired.emplace_back(Simulator::GetContext(), Simulator::Now()); };
+
+  runInContext(3, Seconds(1), [&] { scheduler.schedule(100_ms, record); });
+  runInContext(7, Seconds(1), [&] {
+    scheduler.schedule(50_ms, record);
+    scheduler.schedule(200_ms, record);
+  });
+  runInContext(3, MilliSeconds(1100), [&] { scheduler.schedule(0_ms, record); });
+
+  Simulator::Run();
+
+  // every event runs in the context it was scheduled from, at its expiration time
+  BOOST_REQUIRE_EQUAL(fired.size(), 4);
+  BOOST_CHECK_EQUAL(fired[0].first, 7u);
+  BOOST_CHECK_EQUAL(fired[0].second, MilliSeconds(1050));
+  BOOST_CHECK_EQUAL(fired[1].first, 3u);
+  BOOST_CHECK_EQUAL(fired[1].second, MilliSeconds(1100));
+  BOOST_CHECK_EQUAL(fired[2].first, 3u);
+  BOOST_CHECK_EQUAL(fired[2].second, MilliSeconds(1100));
+  BOOST_CHECK_EQUAL(fired[3].first, 7u);
+  BOOST_CHECK_EQUAL(fired[3].second, MilliSeconds(1200));
+}
+
+BOOST_AUTO_TEST_CASE(OrderAndCancel)
+{
+  std::vector<int> fired;
+  EventId eid;
+
+  runInContext(0, Seconds(1), [&] {
+    scheduler.schedule(20_ms, [&] { fired.push_back(3); });
+    scheduler.schedule(10_ms, [&] { fired.push_back(1); });
+    eid = scheduler.schedule(5_ms, [&] { fired.push_back(0); });
+    scheduler.schedule(10_ms, [&] {
+      fired.push_back(2);
+      // an event scheduled without delay during a callback runs in the same wakeup
+      scheduler.schedule(0_ms, [&] { fired.push_back(4); });
+    });
+  });
+  runInContext(0, MilliSeconds(1001), [&] {
+    BOOST_CHECK(eid);
+    eid.cancel();
+    BOOST_CHECK(!eid);
+  });
+
+  Simulator::Run();
+
+  std::vector<int> expected{1, 2, 4, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(CancelAfterSchedulerDestruction)
+{
+  EventId eid;
+  {
+    Scheduler sched(io);
+    eid = sched.schedule(10_ms, [] { BOOST_ERROR("event should have been canceled"); });
+    BOOST_CHECK(eid);
+  }
+  BOOST_CHECK(!eid);
+  eid.cancel(); // should not crash
+
+  ScopedEventId reused = scheduler.schedule(10_ms, [] {});
+  BOOST_CHECK(reused);
+  BOOST_CHECK(!eid);
+  BOOST_CHECK(eid != reused.release());
+
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
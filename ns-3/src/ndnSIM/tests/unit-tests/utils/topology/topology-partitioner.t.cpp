@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2026  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/names.h"
+
+#include "../../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPO_TXT = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+
+class TopologyPartitionerFixture : public CleanupFixture
+{
+public:
+  TopologyPartitionerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TopologyPartitionerFixture()
+  {
+    boost::filesystem::remove(TEST_TOPO_TXT);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyPartitioner, TopologyPartitionerFixture)
+
+BOOST_AUTO_TEST_CASE(TwoClusters)
+{
+  // two 4-node cliques with 1ms links, connected by a 50ms and a 20ms link
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < 8; ++i) {
+    partitioner.AddNode();
+  }
+  for (uint32_t cluster = 0; cluster < 8; cluster += 4) {
+    for (uint32_t i = 0; i < 4; ++i) {
+      for (uint32_t j = i + 1; j < 4; ++j) {
+        partitioner.AddLink(cluster + i, cluster + j, MilliSeconds(1), 10e6);
+      }
+    }
+  }
+  partitioner.AddLink(0, 4, MilliSeconds(50), 10e6);
+  partitioner.AddLink(3, 7, MilliSeconds(20), 10e6);
+
+  partitioner.Partition(2);
+  for (uint32_t i = 1; i < 4; ++i) {
+    BOOST_CHECK_EQUAL(partitioner.GetPartition(i), partitioner.GetPartition(0));
+    BOOST_CHECK_EQUAL(partitioner.GetPartition(4 + i), partitioner.GetPartition(4));
+  }
+  BOOST_CHECK_NE(partitioner.GetPartition(0), partitioner.GetPartition(4));
+  BOOST_CHECK_EQUAL(partitioner.GetCutSize(), 2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookAhead(), MilliSeconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(LongestLinksAreCut)
+{
+  // a ring of 8 nodes, where the links 1-2 and 5-6 are longer than the others
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < 8; ++i) {
+    partitioner.AddNode();
+  }
+  for (uint32_t i = 0; i < 8; ++i) {
+    bool isLong = i == 1 || i == 5;
+    partitioner.AddLink(i, (i + 1) % 8, MilliSeconds(isLong ? 10 : 1), 10e6);
+  }
+
+  partitioner.Partition(2);
+  BOOST_CHECK_EQUAL(partitioner.GetCutSize(), 2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookAhead(), MilliSeconds(10));
+
+  std::vector<uint32_t> size(2, 0);
+  for (uint32_t i = 0; i < 8; ++i) {
+    size[partitioner.GetPartition(i)]++;
+  }
+  BOOST_CHECK_EQUAL(size[0], 4);
+  BOOST_CHECK_EQUAL(size[1], 4);
+}
+
+BOOST_AUTO_TEST_CASE(SinglePartition)
+{
+  TopologyPartitioner partitioner;
+  partitioner.AddNode();
+  partitioner.AddNode();
+  partitioner.AddLink(0, 1, MilliSeconds(1), 10e6);
+
+  partitioner.Partition(1);
+  BOOST_CHECK_EQUAL(partitioner.GetPartition(0), 0);
+  BOOST_CHECK_EQUAL(partitioner.GetPartition(1), 0);
+  BOOST_CHECK_EQUAL(partitioner.GetCutSize(), 0);
+  BOOST_CHECK_EQUAL(partitioner.GetLookAhead(), Time::Max());
+}
+
+BOOST_AUTO_TEST_CASE(AnnotatedTopology)
+{
+  std::ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A1  NA  1 1 0\n"
+        << "A2  NA  1 2 0\n"
+        << "A3  NA  2 1 0\n"
+        << "B1  NA  5 5 0\n"
+        << "B2  NA  5 6 0\n"
+        << "B3  NA  6 5 0\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A1      A2  10Mbps    1 1ms 100\n"
+        << "A2      A3  10Mbps    1 1ms 100\n"
+        << "A3      A1  10Mbps    1 1ms 100\n"
+        << "B1      B2  10Mbps    1 1ms 100\n"
+        << "B2      B3  10Mbps    1 1ms 100\n"
+        << "B3      B1  10Mbps    1 1ms 100\n"
+        << "A1      B1  10Mbps    1 20ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.SetPartitions(2);
+  topologyReader.Read();
+
+  uint32_t a = Names::Find<Node>("A1")->GetSystemId();
+  uint32_t b = Names::Find<Node>("B1")->GetSystemId();
+  BOOST_CHECK_NE(a, b);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("A2")->GetSystemId(), a);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("A3")->GetSystemId(), a);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("B2")->GetSystemId(), b);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("B3")->GetSystemId(), b);
+}
+
+// Reads a chain of 5 nodes, whose names start with prefix, and returns their system ids
+static std::vector<uint32_t>
+readChain(const std::string& prefix, bool withDuplicates)
+{
+  std::ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n";
+  for (int i = 0; i < 5; ++i) {
+    file1 << prefix << i << "  NA  1 " << i + 1 << " 0\n";
+  }
+  file1 << "\nlink\n\n";
+  for (int i = 0; i + 1 < 5; ++i) {
+    file1 << prefix << i << "  " << prefix << i + 1 << "  10Mbps  1 10ms 100\n";
+  }
+  if (withDuplicates) {
+    // the first link again, the other way around
+    for (int i = 0; i < 4; ++i) {
+      file1 << prefix << 1 << "  " << prefix << 0 << "  10Mbps  1 10ms 100\n";
+    }
+  }
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.SetPartitions(2);
+  topologyReader.Read();
+  BOOST_CHECK_EQUAL(topologyReader.GetLinks().size(), 4);
+
+  std::vector<uint32_t> systemIds;
+  for (int i = 0; i < 5; ++i) {
+    systemIds.push_back(Names::Find<Node>(prefix + std::to_string(i))->GetSystemId());
+  }
+  return systemIds;
+}
+
+BOOST_AUTO_TEST_CASE(AnnotatedTopologyDuplicatedLinks)
+{
+  std::vector<uint32_t> expected = readChain("R", false);
+  std::vector<uint32_t> actual = readChain("D", true);
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -20,6 +20,7 @@
 // Based on the code by Hajime Tazaki <tazaki@sfc.wide.ad.jp>
 
 #include "annotated-topology-reader.hpp"
+#include "topology-partitioner.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -41,6 +42,7 @@
 #include "ns3/error-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/data-rate.h"
 
 #include "model/ndn-l3-protocol.hpp"
 
@@ -65,6 +67,8 @@ NS_LOG_COMPONENT_DEFINE("AnnotatedTopologyReader");
 
 AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double scale /*=1.0*/)
   : m_path(path)
+  , m_partitions(1)
+  , m_maxImbalance(0.1)
   , m_randX(CreateObject<UniformRandomVariable>())
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
@@ -93,6 +97,15 @@ AnnotatedTopologyReader::SetBoundingBox(double ulx, double uly, double lrx, doub
   m_randY->SetAttribute("Max", DoubleValue(lry));
 }
 
+void
+AnnotatedTopologyReader::SetPartitions(uint32_t nPartitions, double maxImbalance /*=0.1*/)
+{
+  NS_LOG_FUNCTION(this << nPartitions << maxImbalance);
+  m_partitions = std::max<uint32_t>(nPartitions, 1);
+  m_maxImbalance = maxImbalance;
+  m_requiredPartitions = m_partitions;
+}
+
 void
 AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
 {
@@ -174,6 +187,16 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  // The nodes are created once the links are known, as they may be needed to partition the nodes
+  struct Router {
+    string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+  vector<Router> routers;
+  map<string, uint32_t> routerIndex;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -183,32 +206,20 @@ AnnotatedTopologyReader::Read(void)
       break; // stop reading nodes
 
     istringstream lineBuffer(line);
-    string name, city;
-    double latitude = 0, longitude = 0;
-    uint32_t systemId = 0;
+    Router router = {"", 0, 0, 0};
+    string city;
 
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
+    lineBuffer >> router.name >> city >> router.latitude >> router.longitude >> router.systemId;
+    if (router.name.empty())
       continue;
 
-    Ptr<Node> node;
-
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
-    }
+    routerIndex[router.name] = routers.size();
+    routers.push_back(router);
   }
 
+  bool hasLinks = !topgen.eof();
+  vector<string> links;
   map<string, set<string>> processedLinks; // to eliminate duplications
-
-  if (topgen.eof()) {
-    NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
-    return m_nodes;
-  }
-
   // SeekToSection ("link");
   while (!topgen.eof()) {
     string line;
@@ -218,12 +229,10 @@ AnnotatedTopologyReader::Read(void)
     if (line[0] == '#')
       continue; // comments
 
-    // NS_LOG_DEBUG ("Input: [" << line << "]");
-
     istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+    string from, to;
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+    lineBuffer >> from >> to;
 
     if (processedLinks[to].size() != 0
         && processedLinks[to].find(from) != processedLinks[to].end()) {
@@ -231,6 +240,60 @@ AnnotatedTopologyReader::Read(void)
     }
     processedLinks[from].insert(to);
 
+    links.push_back(line);
+  }
+  topgen.close();
+
+  if (m_partitions > 1) {
+    TopologyPartitioner partitioner;
+    partitioner.SetMaxImbalance(m_maxImbalance);
+    for (size_t i = 0; i < routers.size(); ++i) {
+      partitioner.AddNode();
+    }
+    for (const string& line : links) {
+      istringstream lineBuffer(line);
+      string from, to, capacity, metric, delay;
+
+      lineBuffer >> from >> to >> capacity >> metric >> delay;
+      if (routerIndex.count(from) == 0 || routerIndex.count(to) == 0)
+        continue; // reported when the link is created
+
+      partitioner.AddLink(routerIndex[from], routerIndex[to], delay.empty() ? Time(0) : Time(delay),
+                          DataRate(capacity).GetBitRate());
+    }
+
+    partitioner.Partition(m_partitions);
+    for (size_t i = 0; i < routers.size(); ++i) {
+      routers[i].systemId = partitioner.GetPartition(i);
+    }
+  }
+
+  for (const Router& router : routers) {
+    Ptr<Node> node;
+
+    if (abs(router.latitude) > 0.001 && abs(router.latitude) > 0.001)
+      node = CreateNode(router.name, m_scale * router.longitude, -m_scale * router.latitude,
+                        router.systemId);
+    else {
+      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+      node = CreateNode(router.name, var->GetValue(0, 200), var->GetValue(0, 200), router.systemId);
+      // node = CreateNode (name, systemId);
+    }
+  }
+
+  if (!hasLinks) {
+    NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
+    return m_nodes;
+  }
+
+  for (const string& line : links) {
+    // NS_LOG_DEBUG ("Input: [" << line << "]");
+
+    istringstream lineBuffer(line);
+    string from, to, capacity, metric, delay, maxPackets, lossRate;
+
+    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+
     Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
     NS_ASSERT_MSG(fromNode != 0, from << " node not found");
     Ptr<Node> toNode = Names::Find<Node>(m_path, to);
@@ -258,7 +321,6 @@ AnnotatedTopologyReader::Read(void)
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
 
   ApplySettings();
 
@@ -98,6 +98,21 @@ public:
   virtual void
   SetMobilityModel(const std::string& model);
 
+  /**
+   * \brief Split the topology into partitions for a distributed or multithreaded run
+   *
+   * If \p nPartitions is more than 1, Read assigns the nodes to \p nPartitions partitions with
+   * TopologyPartitioner, which keeps the links with the shortest delays inside the partitions, and
+   * uses the partitions as system ids of the nodes.  The system ids given in the topology file, if
+   * any, are then ignored.  Must be called before Read.
+   *
+   * \param nPartitions number of partitions (e.g., the number of MPI processes)
+   * \param maxImbalance how much heavier than the average a partition may get: a larger value
+   *        may allow a larger lookahead between the partitions
+   */
+  virtual void
+  SetPartitions(uint32_t nPartitions, double maxImbalance = 0.1);
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -135,6 +150,8 @@ protected:
 protected:
   std::string m_path;
   NodeContainer m_nodes;
+  uint32_t m_partitions; // partitions to compute (see SetPartitions), or 1 to keep system ids
+  double m_maxImbalance;
 
 private:
   AnnotatedTopologyReader(const AnnotatedTopologyReader&);
@@ -20,6 +20,7 @@
 // Based on the code by Hajime Tazaki <tazaki@sfc.wide.ad.jp>
 
 #include "rocketfuel-map-reader.hpp"
+#include "topology-partitioner.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -93,27 +94,36 @@ RocketfuelMapReader::Read()
         "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE     \
         "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
 
+RocketfuelMapReader::LinkParameters
+RocketfuelMapReader::DrawLinkParameters(const string& minBw, const string& maxBw,
+                                        const string& minDelay, const string& maxDelay)
+{
+  LinkParameters params;
+  params.bandwidth = DataRate(
+    m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
+                          static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate())));
+
+  params.delay =
+    Time::FromDouble((m_randVar->GetValue(lexical_cast<Time>(minDelay).ToDouble(Time::US),
+                                          lexical_cast<Time>(maxDelay).ToDouble(Time::US))),
+                     Time::US);
+  return params;
+}
+
 void
 RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double averageRtt,
-                                const string& minBw, const string& maxBw, const string& minDelay,
-                                const string& maxDelay)
+                                const LinkParameters& params)
 {
   Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
   Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
   Link link(node1, nodeName1, node2, nodeName2);
 
-  DataRate randBandwidth(
-    m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
-                          static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate())));
+  const DataRate& randBandwidth = params.bandwidth;
+  const Time& randDelay = params.delay;
 
   int32_t metric = std::max(1, static_cast<int32_t>(1.0 * m_referenceOspfRate.GetBitRate()
                                                     / randBandwidth.GetBitRate()));
 
-  Time randDelay =
-    Time::FromDouble((m_randVar->GetValue(lexical_cast<Time>(minDelay).ToDouble(Time::US),
-                                          lexical_cast<Time>(maxDelay).ToDouble(Time::US))),
-                     Time::US);
-
   uint32_t queue = ceil(averageRtt * (randBandwidth.GetBitRate() / 8.0 / 1100.0));
 
   link.SetAttribute("DataRate", boost::lexical_cast<string>(randBandwidth));
@@ -396,9 +406,65 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
   }
 
+  // The link parameters are drawn before the nodes are created, as they may be needed to
+  // partition the nodes
+  struct GraphLink {
+    Traits::vertex_descriptor u;
+    Traits::vertex_descriptor v;
+    LinkParameters params;
+  };
+  vector<GraphLink> links;
+  for (tie(e, ende) = edges(m_graph); e != ende; e++) {
+    Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
+
+    node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
+
+    LinkParameters linkParams;
+    if (u_type == BACKBONE && v_type == BACKBONE) {
+      linkParams = DrawLinkParameters(params.minb2bBandwidth, params.maxb2bBandwidth,
+                                      params.minb2bDelay, params.maxb2bDelay);
+    }
+    else if ((u_type == GATEWAY && v_type == BACKBONE)
+             || (u_type == BACKBONE && v_type == GATEWAY)) {
+      linkParams = DrawLinkParameters(params.minb2gBandwidth, params.maxb2gBandwidth,
+                                      params.minb2gDelay, params.maxb2gDelay);
+    }
+    else if (u_type == GATEWAY && v_type == GATEWAY) {
+      linkParams = DrawLinkParameters(params.minb2gBandwidth, params.maxb2gBandwidth,
+                                      params.minb2gDelay, params.maxb2gDelay);
+    }
+    else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
+      linkParams = DrawLinkParameters(params.ming2cBandwidth, params.maxg2cBandwidth,
+                                      params.ming2cDelay, params.maxg2cDelay);
+    }
+    else {
+      NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
+    }
+    links.push_back({u, v, linkParams});
+  }
+
+  map<Traits::vertex_descriptor, uint32_t> systemIds;
+  if (m_partitions > 1) {
+    TopologyPartitioner partitioner;
+    partitioner.SetMaxImbalance(m_maxImbalance);
+    map<Traits::vertex_descriptor, uint32_t> nodeIndex;
+    for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
+      nodeIndex[*v] = partitioner.AddNode();
+    }
+    for (const GraphLink& link : links) {
+      partitioner.AddLink(nodeIndex[link.u], nodeIndex[link.v], link.params.delay,
+                          link.params.bandwidth.GetBitRate());
+    }
+
+    partitioner.Partition(m_partitions);
+    for (const auto& node : nodeIndex) {
+      systemIds[node.first] = partitioner.GetPartition(node.second);
+    }
+  }
+
   for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
     string nodeName = get(vertex_name, m_graph, *v);
-    Ptr<Node> node = CreateNode(nodeName, 0);
+    Ptr<Node> node = CreateNode(nodeName, systemIds[*v]);
 
     node_type_t type = get(vertex_rank, m_graph, *v);
     switch (type) {
@@ -423,33 +489,10 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     }
   }
 
-  for (tie(e, ende) = edges(m_graph); e != ende; e++) {
-    Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
-
-    node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
-
-    string u_name = get(vertex_name, m_graph, u), v_name = get(vertex_name, m_graph, v);
+  for (const GraphLink& link : links) {
+    string u_name = get(vertex_name, m_graph, link.u), v_name = get(vertex_name, m_graph, link.v);
 
-    if (u_type == BACKBONE && v_type == BACKBONE) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth, params.maxb2bBandwidth,
-                 params.minb2bDelay, params.maxb2bDelay);
-    }
-    else if ((u_type == GATEWAY && v_type == BACKBONE)
-             || (u_type == BACKBONE && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
-    }
-    else if (u_type == GATEWAY && v_type == GATEWAY) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
-    }
-    else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth, params.maxg2cBandwidth,
-                 params.ming2cDelay, params.maxg2cDelay);
-    }
-    else {
-      NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
-    }
+    CreateLink(u_name, v_name, params.averageRtt, link.params);
   }
 
   ApplySettings();
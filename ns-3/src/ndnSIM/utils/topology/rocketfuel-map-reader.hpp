@@ -26,6 +26,7 @@
 
 #include "ns3/net-device-container.h"
 #include "ns3/data-rate.h"
+#include "ns3/nstime.h"
 
 #include <set>
 #include <boost/graph/adjacency_list.hpp>
@@ -133,9 +134,17 @@ private:
   void
   GenerateFromMapsFile(int argc, char* argv[]);
 
+  struct LinkParameters {
+    DataRate bandwidth;
+    Time delay;
+  };
+
+  LinkParameters
+  DrawLinkParameters(const string& minBw, const string& maxBw, const string& minDelay,
+                     const string& maxDelay);
+
   void
-  CreateLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
-             const string& maxBw, const string& minDelay, const string& maxDelay);
+  CreateLink(string nodeName1, string nodeName2, double averageRtt, const LinkParameters& params);
   void
   KeepOnlyBiggestConnectedComponent();
 
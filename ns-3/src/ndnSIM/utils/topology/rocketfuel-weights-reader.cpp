@@ -20,6 +20,7 @@
 // Based on the code by Hajime Tazaki <tazaki@sfc.wide.ad.jp>
 
 #include "rocketfuel-weights-reader.hpp"
+#include "topology-partitioner.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -38,6 +39,7 @@
 #include "ns3/pointer.h"
 #include "ns3/uinteger.h"
 #include "ns3/ipv4-address.h"
+#include "ns3/data-rate.h"
 
 #include "ns3/mobility-model.h"
 
@@ -99,6 +101,7 @@ RocketfuelWeightsReader::Read()
   bool repeatedRun = LinksSize() > 0;
   std::list<Link>::iterator linkIterator = m_linksList.begin();
 
+  vector<string> lines;
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -107,6 +110,49 @@ RocketfuelWeightsReader::Read()
     if (line[0] == '#')
       continue; // comments
 
+    lines.push_back(line);
+  }
+  topgen.close();
+
+  // The first file creates the nodes, so it alone can partition them
+  map<string, uint32_t> systemIds;
+  if (m_partitions > 1 && !repeatedRun) {
+    TopologyPartitioner partitioner;
+    partitioner.SetMaxImbalance(m_maxImbalance);
+    map<string, uint32_t> nodeIndex;
+    map<string, set<string>> partitionedLinks;
+    for (const string& line : lines) {
+      istringstream lineBuffer(line);
+      string from, to, attribute;
+
+      lineBuffer >> from >> to >> attribute;
+
+      if (partitionedLinks[to].count(from) != 0) {
+        continue; // duplicated link
+      }
+      partitionedLinks[from].insert(to);
+
+      for (const string& name : {from, to}) {
+        if (nodeIndex.count(name) == 0) {
+          nodeIndex[name] = partitioner.AddNode();
+        }
+      }
+
+      // Without latencies, all the links get the default latency of 1ms
+      Time delay = MilliSeconds(1);
+      if (m_inputType == LATENCIES && attribute != "")
+        delay = Time(attribute + "ms");
+      partitioner.AddLink(nodeIndex[from], nodeIndex[to], delay,
+                          DataRate(m_defaultBandwidth).GetBitRate());
+    }
+
+    partitioner.Partition(m_partitions);
+    for (const auto& node : nodeIndex) {
+      systemIds[node.first] = partitioner.GetPartition(node.second);
+    }
+  }
+
+  for (const string& line : lines) {
     // NS_LOG_DEBUG ("Input: [" << line << "]");
 
     istringstream lineBuffer(line);
@@ -122,12 +168,12 @@ RocketfuelWeightsReader::Read()
 
     Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
     if (fromNode == 0) {
-      fromNode = CreateNode(from, 0);
+      fromNode = CreateNode(from, systemIds[from]);
     }
 
     Ptr<Node> toNode = Names::Find<Node>(m_path, to);
     if (toNode == 0) {
-      toNode = CreateNode(to, 0);
+      toNode = CreateNode(to, systemIds[to]);
     }
 
     Link* link;
@@ -174,8 +220,6 @@ RocketfuelWeightsReader::Read()
     }
   }
 
-  topgen.close();
-
   if (!repeatedRun) {
     NS_LOG_INFO("Rocketfuel topology created with " << m_nodes.GetN() << " nodes and "
                                                     << LinksSize() << " links");
@@ -0,0 +1,373 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2026  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+static const uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+
+// Maximum number of passes moving nodes between partitions to reduce the cut
+static const uint32_t MAX_REFINE_PASSES = 20;
+
+TopologyPartitioner::TopologyPartitioner()
+  : m_nNodes(0)
+  , m_maxImbalance(0.1)
+  , m_lookAhead(Time::Max())
+  , m_cutSize(0)
+{
+}
+
+uint32_t
+TopologyPartitioner::AddNode()
+{
+  return m_nNodes++;
+}
+
+void
+TopologyPartitioner::AddLink(uint32_t from, uint32_t to, Time delay, double capacity)
+{
+  NS_ASSERT(from < m_nNodes && to < m_nNodes);
+  if (from == to) {
+    return;
+  }
+  m_links.push_back({from, to, delay, capacity});
+}
+
+void
+TopologyPartitioner::SetMaxImbalance(double imbalance)
+{
+  m_maxImbalance = imbalance;
+}
+
+uint32_t
+TopologyPartitioner::GetPartition(uint32_t node) const
+{
+  NS_ASSERT(node < m_partition.size());
+  return m_partition[node];
+}
+
+Time
+TopologyPartitioner::GetLookAhead() const
+{
+  return m_lookAhead;
+}
+
+uint32_t
+TopologyPartitioner::GetCutSize() const
+{
+  return m_cutSize;
+}
+
+void
+TopologyPartitioner::Partition(uint32_t nPartitions)
+{
+  NS_LOG_FUNCTION(this << nPartitions);
+
+  m_partition.assign(m_nNodes, 0);
+  m_lookAhead = Time::Max();
+  m_cutSize = 0;
+  if (nPartitions <= 1 || m_nNodes == 0) {
+    return;
+  }
+
+  // The load of a node is 1 for the node itself, plus its share of the traffic, estimated from
+  // the capacity of its links: both add up to the same total.
+  std::vector<double> traffic(m_nNodes, 0);
+  double totalTraffic = 0;
+  for (const Link& link : m_links) {
+    traffic[link.from] += link.capacity;
+    traffic[link.to] += link.capacity;
+    totalTraffic += 2 * link.capacity;
+  }
+  std::vector<double> nodeLoad(m_nNodes, 1);
+  double totalLoad = m_nNodes;
+  if (totalTraffic > 0) {
+    for (uint32_t i = 0; i < m_nNodes; ++i) {
+      nodeLoad[i] += traffic[i] * m_nNodes / totalTraffic;
+    }
+    totalLoad += m_nNodes;
+  }
+  double maxLoad = (1 + m_maxImbalance) * totalLoad / nPartitions;
+
+  // Try to keep the links shorter than each delay inside the partitions, from the largest delay
+  // down, until the rest can be balanced.  Keeping no link (a delay of 0) always works when the
+  // balance is not enforced.
+  std::vector<Time> delays;
+  for (const Link& link : m_links) {
+    delays.push_back(link.delay);
+  }
+  delays.push_back(Time(0));
+  std::sort(delays.begin(), delays.end(), std::greater<Time>());
+  delays.erase(std::unique(delays.begin(), delays.end()), delays.end());
+
+  bool isBalanced = false;
+  for (const Time& delay : delays) {
+    if (PartitionGroups(nPartitions, delay, nodeLoad, maxLoad, m_partition)) {
+      NS_LOG_DEBUG("Links shorter than " << delay << " are kept inside the partitions");
+      isBalanced = true;
+      break;
+    }
+  }
+  if (!isBalanced) {
+    NS_LOG_WARN("Cannot balance " << m_nNodes << " nodes between " << nPartitions
+                                  << " partitions");
+    PartitionGroups(nPartitions, Time(0), nodeLoad, std::numeric_limits<double>::max(),
+                    m_partition);
+  }
+
+  for (const Link& link : m_links) {
+    if (m_partition[link.from] != m_partition[link.to]) {
+      m_lookAhead = std::min(m_lookAhead, link.delay);
+      m_cutSize++;
+    }
+  }
+  NS_LOG_INFO(m_nNodes << " nodes split into " << nPartitions << " partitions, " << m_cutSize
+                       << " links between partitions, lookahead " << m_lookAhead);
+  if (m_cutSize > 0 && !m_lookAhead.IsStrictlyPositive()) {
+    NS_LOG_WARN("Links without delay cross partitions");
+  }
+}
+
+bool
+TopologyPartitioner::PartitionGroups(uint32_t nPartitions, Time minDelay,
+                                     const std::vector<double>& nodeLoad, double maxLoad,
+                                     std::vector<uint32_t>& partition) const
+{
+  // Merge the nodes connected by links shorter than minDelay into groups
+  std::vector<uint32_t> parent(m_nNodes);
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    parent[i] = i;
+  }
+  auto findRoot = [&parent] (uint32_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  for (const Link& link : m_links) {
+    if (link.delay < minDelay) {
+      uint32_t from = findRoot(link.from);
+      uint32_t to = findRoot(link.to);
+      parent[std::max(from, to)] = std::min(from, to);
+    }
+  }
+
+  std::vector<uint32_t> nodeGroup(m_nNodes);
+  std::vector<uint32_t> rootGroup(m_nNodes, UNASSIGNED);
+  std::vector<double> load;
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    uint32_t root = findRoot(i);
+    if (rootGroup[root] == UNASSIGNED) {
+      rootGroup[root] = load.size();
+      load.push_back(0);
+    }
+    nodeGroup[i] = rootGroup[root];
+    load[nodeGroup[i]] += nodeLoad[i];
+    if (load[nodeGroup[i]] > maxLoad) {
+      return false;
+    }
+  }
+  uint32_t nGroups = load.size();
+
+  // Number of links between groups (std::map keeps the iteration order deterministic)
+  std::vector<std::map<uint32_t, uint32_t>> neighbors(nGroups);
+  for (const Link& link : m_links) {
+    uint32_t from = nodeGroup[link.from];
+    uint32_t to = nodeGroup[link.to];
+    if (from != to) {
+      neighbors[from][to]++;
+      neighbors[to][from]++;
+    }
+  }
+
+  // Grow the partitions one by one, from the unassigned group with the fewest links to the
+  // other unassigned groups, adding the group most connected to the partition until it gets
+  // its share of the remaining load.  The last partition takes the remaining groups.
+  std::vector<uint32_t> groupPartition(nGroups, UNASSIGNED);
+  std::vector<double> partitionLoad(nPartitions, 0);
+  std::vector<uint32_t> partitionSize(nPartitions, 0);
+  auto assign = [&] (uint32_t group, uint32_t p) {
+    groupPartition[group] = p;
+    partitionLoad[p] += load[group];
+    partitionSize[p]++;
+  };
+
+  double remainingLoad = 0;
+  for (double groupLoad : load) {
+    remainingLoad += groupLoad;
+  }
+  for (uint32_t p = 0; p + 1 < nPartitions; ++p) {
+    double target = remainingLoad / (nPartitions - p);
+    std::vector<uint32_t> connection(nGroups, 0);
+
+    while (partitionLoad[p] < target) {
+      uint32_t next = UNASSIGNED;
+      for (uint32_t g = 0; g < nGroups; ++g) {
+        if (groupPartition[g] != UNASSIGNED || connection[g] == 0
+            || partitionLoad[p] + load[g] > maxLoad) {
+          continue;
+        }
+        if (next == UNASSIGNED || connection[g] > connection[next]) {
+          next = g;
+        }
+      }
+
+      if (next == UNASSIGNED) {
+        // Nothing left around the partition: start from a new peripheral group
+        uint32_t minLinks = UNASSIGNED;
+        for (uint32_t g = 0; g < nGroups; ++g) {
+          if (groupPartition[g] != UNASSIGNED || partitionLoad[p] + load[g] > maxLoad) {
+            continue;
+          }
+          uint32_t links = 0;
+          for (const auto& neighbor : neighbors[g]) {
+            if (groupPartition[neighbor.first] == UNASSIGNED) {
+              links += neighbor.second;
+            }
+          }
+          if (links < minLinks) {
+            minLinks = links;
+            next = g;
+          }
+        }
+      }
+
+      if (next == UNASSIGNED) {
+        break;
+      }
+      if (partitionSize[p] > 0
+          && partitionLoad[p] + load[next] - target > target - partitionLoad[p]) {
+        // one more group would take the partition further from its target
+        break;
+      }
+
+      assign(next, p);
+      for (const auto& neighbor : neighbors[next]) {
+        connection[neighbor.first] += neighbor.second;
+      }
+    }
+    remainingLoad -= partitionLoad[p];
+  }
+  for (uint32_t g = 0; g < nGroups; ++g) {
+    if (groupPartition[g] == UNASSIGNED) {
+      assign(g, nPartitions - 1);
+    }
+  }
+
+  // Links from a group to each partition
+  auto getConnections = [&] (uint32_t group) {
+    std::vector<uint32_t> connections(nPartitions, 0);
+    for (const auto& neighbor : neighbors[group]) {
+      connections[groupPartition[neighbor.first]] += neighbor.second;
+    }
+    return connections;
+  };
+  auto move = [&] (uint32_t group, uint32_t to) {
+    uint32_t from = groupPartition[group];
+    partitionLoad[from] -= load[group];
+    partitionSize[from]--;
+    assign(group, to);
+  };
+
+  // Unload the partitions which are too heavy, cutting as few links as possible
+  for (uint32_t from = 0; from < nPartitions; ++from) {
+    while (partitionLoad[from] > maxLoad) {
+      uint32_t bestGroup = UNASSIGNED;
+      uint32_t bestTo = UNASSIGNED;
+      int64_t bestGain = 0;
+      for (uint32_t g = 0; g < nGroups; ++g) {
+        if (groupPartition[g] != from) {
+          continue;
+        }
+        std::vector<uint32_t> connections = getConnections(g);
+        for (uint32_t to = 0; to < nPartitions; ++to) {
+          if (to == from || partitionLoad[to] + load[g] > maxLoad) {
+            continue;
+          }
+          int64_t gain = static_cast<int64_t>(connections[to]) - connections[from];
+          if (bestGroup == UNASSIGNED || gain > bestGain) {
+            bestGroup = g;
+            bestTo = to;
+            bestGain = gain;
+          }
+        }
+      }
+      if (bestGroup == UNASSIGNED) {
+        return false;
+      }
+      move(bestGroup, bestTo);
+    }
+  }
+
+  // Move groups to the partition they have the most links to, or to a lighter partition if that
+  // does not cut more links, as long as this keeps the partitions balanced and not empty
+  for (uint32_t pass = 0; pass < MAX_REFINE_PASSES; ++pass) {
+    bool isMoved = false;
+    for (uint32_t g = 0; g < nGroups; ++g) {
+      uint32_t from = groupPartition[g];
+      if (partitionSize[from] == 1) {
+        continue;
+      }
+      std::vector<uint32_t> connections = getConnections(g);
+      uint32_t bestTo = UNASSIGNED;
+      for (uint32_t to = 0; to < nPartitions; ++to) {
+        if (to == from || partitionLoad[to] + load[g] > maxLoad) {
+          continue;
+        }
+        bool isBetter = connections[to] > connections[from]
+                        || (connections[to] == connections[from]
+                            && partitionLoad[to] + load[g] < partitionLoad[from]);
+        if (!isBetter) {
+          continue;
+        }
+        if (bestTo == UNASSIGNED || connections[to] > connections[bestTo]
+            || (connections[to] == connections[bestTo]
+                && partitionLoad[to] < partitionLoad[bestTo])) {
+          bestTo = to;
+        }
+      }
+      if (bestTo != UNASSIGNED) {
+        move(g, bestTo);
+        isMoved = true;
+      }
+    }
+    if (!isMoved) {
+      break;
+    }
+  }
+
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    partition[i] = groupPartition[nodeGroup[i]];
+  }
+  return true;
+}
+
+} // namespace ns3
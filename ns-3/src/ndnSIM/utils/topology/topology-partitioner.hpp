@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2026  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Splits a topology into partitions for a distributed or multithreaded run
+ *
+ * The partitions are meant to become the system ids of the nodes, for
+ * ns3::DistributedSimulatorImpl or ns3::MultithreadedSimulatorImpl.  Both advance the partitions
+ * in windows as long as the smallest delay of the links between two partitions (the
+ * lookahead), so the partitioner:
+ *
+ * 1. maximizes the lookahead: it merges the nodes connected by the shortest links into groups
+ *    that are never split, for the largest delay which still leaves a balanced partitioning;
+ * 2. balances the load of the partitions, where the load of a node counts the node itself and
+ *    its expected traffic, estimated from the capacity of its links;
+ * 3. minimizes the number of links between partitions, by growing each partition from a
+ *    peripheral node, then moving the nodes on the boundary as long as this reduces the cut.
+ *
+ * The result is deterministic: it only depends on the order of the nodes and the links.
+ */
+class TopologyPartitioner {
+public:
+  TopologyPartitioner();
+
+  /**
+   * \brief Add a node
+   * \return the index of the node, starting from 0
+   */
+  uint32_t
+  AddNode();
+
+  /**
+   * \brief Add a link between two nodes
+   * \param from index of the first node
+   * \param to index of the second node
+   * \param delay propagation delay of the link
+   * \param capacity capacity of the link (bits per second), used to estimate the traffic
+   */
+  void
+  AddLink(uint32_t from, uint32_t to, Time delay, double capacity);
+
+  /**
+   * \brief Set how much heavier than the average a partition may get (default 0.1, i.e., 10%)
+   */
+  void
+  SetMaxImbalance(double imbalance);
+
+  /**
+   * \brief Split the nodes into \p nPartitions partitions
+   *
+   * Partitions may be left empty if there are fewer nodes than partitions.
+   */
+  void
+  Partition(uint32_t nPartitions);
+
+  /**
+   * \brief Get the partition of a node, as computed by the last call to Partition
+   */
+  uint32_t
+  GetPartition(uint32_t node) const;
+
+  /**
+   * \brief Get the smallest delay of the links between two partitions
+   *
+   * Time::Max() if no link crosses partitions.
+   */
+  Time
+  GetLookAhead() const;
+
+  /**
+   * \brief Get the number of links between two partitions
+   */
+  uint32_t
+  GetCutSize() const;
+
+private:
+  struct Link {
+    uint32_t from;
+    uint32_t to;
+    Time delay;
+    double capacity;
+  };
+
+  /**
+   * \brief Partition the groups of nodes connected by links shorter than \p minDelay
+   * \return false if the partitions cannot be balanced
+   */
+  bool
+  PartitionGroups(uint32_t nPartitions, Time minDelay, const std::vector<double>& nodeLoad,
+                  double maxLoad, std::vector<uint32_t>& partition) const;
+
+private:
+  uint32_t m_nNodes;
+  std::vector<Link> m_links;
+  double m_maxImbalance;
+
+  std::vector<uint32_t> m_partition;
+  Time m_lookAhead;
+  uint32_t m_cutSize;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
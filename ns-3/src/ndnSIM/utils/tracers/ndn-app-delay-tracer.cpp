@@ -33,6 +33,7 @@
 #include <boost/make_shared.hpp>
 
 #include <fstream>
+#include <mutex>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
@@ -42,6 +43,10 @@ namespace ndn {
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
   g_tracers;
 
+// The tracers of all the nodes share the output stream; under ns3::MultithreadedSimulatorImpl,
+// the application events of different nodes may run on different threads
+static std::mutex g_outputMutex;
+
 void
 AppDelayTracer::Destroy()
 {
@@ -234,6 +239,7 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  std::lock_guard<std::mutex> lock(g_outputMutex);
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +251,7 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  std::lock_guard<std::mutex> lock(g_outputMutex);
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -82,7 +82,7 @@ public:
    * \brief Get the node list object
    * \returns the node list
    */
-  static Ptr<NodeListPriv> Get (void);
+  static NodeListPriv *Get (void);
 
 private:
   /**
@@ -120,11 +120,13 @@ NodeListPriv::GetTypeId (void)
   return tid;
 }
 
-Ptr<NodeListPriv> 
+NodeListPriv *
 NodeListPriv::Get (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  return *DoGet ();
+  // No reference is taken, so that the threads of a multithreaded
+  // simulation can look up nodes without sharing a reference count.
+  return PeekPointer (*DoGet ());
 }
 Ptr<NodeListPriv> *
 NodeListPriv::DoGet (void)
@@ -800,7 +800,11 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  /**
+   * Counter of packets Uid.  It is per thread: the upper 32 bits of the Uid,
+   * the system id, tell apart the threads of a multithreaded simulation.
+   */
+  static thread_local uint32_t m_globalUid;
 };
 
 /**
@@ -31,6 +31,7 @@
 #include "ns3/names.h"
 #include "ns3/mpi-interface.h"
 #include "ns3/mpi-receiver.h"
+#include "ns3/multithreaded-simulator-impl.h"
 
 #include "ns3/trace-helper.h"
 #include "point-to-point-helper.h"
@@ -256,6 +257,8 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
   // If MPI is enabled, we need to see if both nodes have the same system id 
   // (rank), and the rank is the same as this instance.  If both are true, 
   //use a normal p2p channel, otherwise use a remote channel
+  // With the multithreaded simulator, nodes with different system ids run
+  // on different threads, and also need a remote channel.
   bool useNormalChannel = true;
   Ptr<PointToPointChannel> channel = 0;
 
@@ -269,6 +272,10 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
           useNormalChannel = false;
         }
     }
+  else if (MultithreadedSimulatorImpl::IsEnabled ())
+    {
+      useNormalChannel = a->GetSystemId () == b->GetSystemId ();
+    }
   if (useNormalChannel)
     {
       channel = m_channelFactory.Create<PointToPointChannel> ();
@@ -276,12 +283,15 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
   else
     {
       channel = m_remoteChannelFactory.Create<PointToPointRemoteChannel> ();
-      Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
-      Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
-      mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devA));
-      mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devB));
-      devA->AggregateObject (mpiRecA);
-      devB->AggregateObject (mpiRecB);
+      if (MpiInterface::IsEnabled ())
+        {
+          Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
+          Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
+          mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devA));
+          mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devB));
+          devA->AggregateObject (mpiRecA);
+          devB->AggregateObject (mpiRecB);
+        }
     }
 
   devA->Attach (channel);
@@ -26,6 +26,8 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/mpi-interface.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/unused.h"
 
 namespace ns3 {
 
@@ -45,8 +47,14 @@ PointToPointRemoteChannel::GetTypeId (void)
 }
 
 PointToPointRemoteChannel::PointToPointRemoteChannel ()
-  : PointToPointChannel ()
+  : PointToPointChannel (),
+    m_multithreaded (MultithreadedSimulatorImpl::IsEnabled ())
 {
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      m_dst[i] = 0;
+      m_dstContext[i] = Simulator::NO_CONTEXT;
+    }
 }
 
 PointToPointRemoteChannel::~PointToPointRemoteChannel ()
@@ -64,10 +72,26 @@ PointToPointRemoteChannel::TransmitStart (
 
   IsInitialized ();
 
+  if (m_multithreaded)
+    {
+      // The destination runs on another thread: do not touch its
+      // reference count, nor share the packet buffer with it.
+      uint32_t wire = PeekPointer (src) == m_dst[1] ? 0 : 1;
+      std::vector<uint8_t> &buffer = m_buffer[wire];
+      buffer.resize (p->GetSerializedSize ());
+      uint32_t ok = p->Serialize (&buffer[0], buffer.size ());
+      NS_ASSERT (ok);
+      NS_UNUSED (ok);
+      Ptr<Packet> copy = Create<Packet> (&buffer[0], buffer.size (), true);
+      Simulator::ScheduleWithContext (m_dstContext[wire], txTime + GetDelay (),
+                                      &PointToPointNetDevice::Receive, m_dst[wire], copy);
+      return true;
+    }
+
+#ifdef NS3_MPI
   uint32_t wire = src == GetSource (0) ? 0 : 1;
   Ptr<PointToPointNetDevice> dst = GetDestination (wire);
 
-#ifdef NS3_MPI
   // Calculate the rxTime (absolute)
   Time rxTime = Simulator::Now () + txTime + GetDelay ();
   MpiInterface::SendPacket (p->Copy (), rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
@@ -77,4 +101,20 @@ PointToPointRemoteChannel::TransmitStart (
   return true;
 }
 
+void
+PointToPointRemoteChannel::Attach (Ptr<PointToPointNetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  PointToPointChannel::Attach (device);
+  if (GetNDevices () == 2)
+    {
+      for (uint32_t i = 0; i < 2; ++i)
+        {
+          Ptr<PointToPointNetDevice> dst = GetDestination (i);
+          m_dst[i] = PeekPointer (dst);
+          m_dstContext[i] = dst->GetNode () ? dst->GetNode ()->GetId () : Simulator::NO_CONTEXT;
+        }
+    }
+}
+
 } // namespace ns3
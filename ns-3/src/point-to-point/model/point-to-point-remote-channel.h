@@ -20,12 +20,15 @@
 
 // This object connects two point-to-point net devices where at least one
 // is not local to this simulator object.  It simply over-rides the transmit
-// method and uses an MPI Send operation instead.
+// method and uses an MPI Send operation instead, or hands a private copy of
+// the packet to the other thread under MultithreadedSimulatorImpl.
 
 #ifndef POINT_TO_POINT_REMOTE_CHANNEL_H
 #define POINT_TO_POINT_REMOTE_CHANNEL_H
 
 #include "point-to-point-channel.h"
+#include <stdint.h>
+#include <vector>
 
 namespace ns3 {
 
@@ -37,6 +40,12 @@ namespace ns3 {
  * This object connects two point-to-point net devices where at least one
  * is not local to this simulator object. It simply override the transmit
  * method and uses an MPI Send operation instead.
+ *
+ * When MultithreadedSimulatorImpl is selected, the two devices are local
+ * but run on different threads: the packet is then deep-copied through
+ * its serialized form, so that the two threads never share a buffer or
+ * a reference count, and its reception is scheduled in the context of
+ * the destination node.
  */
 class PointToPointRemoteChannel : public PointToPointChannel
 {
@@ -68,6 +77,27 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
                               Time txTime);
+
+  /**
+   * \brief Attach a given netdevice to this channel
+   *
+   * Once both devices are attached, this also records the devices and
+   * the ids of their nodes, so that TransmitStart never has to take a
+   * reference on an object owned by another thread.
+   *
+   * \param device pointer to the netdevice to attach to the channel
+   */
+  virtual void Attach (Ptr<PointToPointNetDevice> device);
+
+private:
+  /** Whether MultithreadedSimulatorImpl runs the simulation. */
+  bool m_multithreaded;
+  /** The device at the receiving end of each wire; wire i starts at m_dst[1 - i]. */
+  PointToPointNetDevice *m_dst[2];
+  /** The id of the node of m_dst[i], which is the context of its receive events. */
+  uint32_t m_dstContext[2];
+  /** Scratch space to serialize the packets sent on each wire. */
+  std::vector<uint8_t> m_buffer[2];
 };
 
 } // namespace ns3
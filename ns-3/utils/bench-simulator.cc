@@ -18,9 +18,12 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <vector>
 #include <string.h>
 
@@ -82,8 +85,11 @@ public:
     m_total = total;
   }
 
-  /// Run function
-  void RunBench (void);
+  /**
+   * Run function
+   * \returns the simulation time, in seconds
+   */
+  double RunBench (void);
 private:
   /// callback function
   void Cb (void);
@@ -94,7 +100,7 @@ private:
   uint32_t m_count; ///< count 
 };
 
-void
+double
 Bench::RunBench (void)
 {
   SystemWallClockMs time;
@@ -128,6 +134,7 @@ Bench::RunBench (void)
        std::setw (g_fwidth) << (m_count / simu) <<
        std::setw (g_fwidth) << (simu / m_count));
 
+  return simu;
 }
 
 void
@@ -145,17 +152,20 @@ Bench::Cb (void)
 }
 
 
-Ptr<RandomVariableStream>
-GetRandomStream (std::string filename)
+/**
+ * Read the event intervals.
+ * \param filename the file of relative event times, "-" for standard
+ *        input, or empty for the exponential distribution
+ * \returns the intervals in ns, or empty for the exponential distribution
+ */
+std::vector<double>
+GetIntervals (std::string filename)
 {
-  Ptr<RandomVariableStream> stream = 0;
+  std::vector<double> nsValues;
 
   if (filename == "")
     {
       LOGME ("using default exponential distribution");
-      Ptr<ExponentialRandomVariable> erv = CreateObject<ExponentialRandomVariable> ();
-      erv->SetAttribute ("Mean", DoubleValue (100));
-      stream = erv;
     }
   else
     {
@@ -173,7 +183,6 @@ GetRandomStream (std::string filename)
         }
 
       double value;
-      std::vector<double> nsValues;
 
       while (!input->eof ())
         {
@@ -190,6 +199,33 @@ GetRandomStream (std::string filename)
             }
         }
       LOGME ("found " << nsValues.size () << " entries");
+    }
+
+  return nsValues;
+}
+
+
+/**
+ * Make a stream of event intervals, starting over at each call,
+ * so that each run sees the same intervals.
+ * \param nsValues the intervals read from the file, or empty for the
+ *        exponential distribution
+ * \returns the random variable stream
+ */
+Ptr<RandomVariableStream>
+GetRandomStream (std::vector<double> &nsValues)
+{
+  Ptr<RandomVariableStream> stream = 0;
+
+  if (nsValues.empty ())
+    {
+      Ptr<ExponentialRandomVariable> erv = CreateObject<ExponentialRandomVariable> ();
+      erv->SetAttribute ("Mean", DoubleValue (100));
+      erv->SetStream (0);
+      stream = erv;
+    }
+  else
+    {
       Ptr<DeterministicRandomVariable> drv = CreateObject<DeterministicRandomVariable> ();
       drv->SetValueArray (&nsValues[0], nsValues.size ());
       stream = drv;
@@ -199,14 +235,15 @@ GetRandomStream (std::string filename)
 }
 
 
-
 int main (int argc, char *argv[])
 {
 
-  bool schedCal  = false;
-  bool schedHeap = false;
-  bool schedList = false;
-  bool schedMap  = true;
+  bool schedCal    = false;
+  bool schedHeap   = false;
+  bool schedList   = false;
+  bool schedMap    = false;
+  bool schedLadder = false;
+  bool schedAll    = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
@@ -221,11 +258,22 @@ int main (int argc, char *argv[])
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in seconds.\n"
+             "ns3::EventTraceScheduler of the qsccp scenarios records\n"
+             "such a file.\n"
+             "\n"
+             "With several scheduler options, or --all, the same event\n"
+             "intervals are run through each scheduler in turn, so that\n"
+             "they can be compared.\n"
+             "The runs of the schedulers are interleaved, and the median\n"
+             "and standard deviation of their simulation times are\n"
+             "printed at the end.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
+  cmd.AddValue ("all",   "run with each scheduler in turn", schedAll);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
@@ -236,38 +284,51 @@ int main (int argc, char *argv[])
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
-  ObjectFactory factory ("ns3::MapScheduler");
-  if (schedCal)
+  std::vector<std::string> schedulers;
+  if (schedList || schedAll)
+    {
+      schedulers.push_back ("ns3::ListScheduler");
+    }
+  if (schedMap || schedAll)
     {
-      factory.SetTypeId ("ns3::CalendarScheduler");
+      schedulers.push_back ("ns3::MapScheduler");
     }
-  if (schedHeap)
+  if (schedHeap || schedAll)
     {
-      factory.SetTypeId ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::HeapScheduler");
     }
-  if (schedList)
+  if (schedCal || schedAll)
     {
-      factory.SetTypeId ("ns3::ListScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
+    }
+  if (schedLadder || schedAll)
+    {
+      schedulers.push_back ("ns3::LadderScheduler");
+    }
+  if (schedulers.empty ())
+    {
+      schedulers.push_back ("ns3::MapScheduler");
     }
-  Simulator::SetScheduler (factory);
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
 
-  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
 
   Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
+  std::vector<double> intervals = GetIntervals (filename);
 
   // table header
+  int swidth = 24;
   LOG ("");
-  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+  LOG (std::left << std::setw (swidth) << "Scheduler" <<
+       std::left << std::setw (g_fwidth) << "Run #" <<
        std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
        std::left << std::setw (3 * g_fwidth) << "Simulation:");
-  LOG (std::left << std::setw (g_fwidth) << "" <<
+  LOG (std::left << std::setw (swidth) << "" <<
+       std::left << std::setw (g_fwidth) << "" <<
        std::left << std::setw (g_fwidth) << "Time (s)" <<
        std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
        std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
@@ -275,6 +336,7 @@ int main (int argc, char *argv[])
        std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
        std::left << std::setw (g_fwidth) << "Per (s/ev)" );
   LOG (std::setfill ('-') <<
+       std::right << std::setw (swidth) << " " <<
        std::right << std::setw (g_fwidth) << " " <<
        std::right << std::setw (g_fwidth) << " " <<
        std::right << std::setw (g_fwidth) << " " <<
@@ -285,18 +347,63 @@ int main (int argc, char *argv[])
        std::setfill (' ')
        );
 
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
+  // run -1 primes each scheduler; the runs of the schedulers are
+  // interleaved, so that drifts of the machine hit all of them alike
+  std::map<std::string, std::vector<double> > times;
+  for (int64_t i = -1; i < (int64_t) runs; i++)
+    {
+      for (std::vector<std::string>::const_iterator s = schedulers.begin ();
+           s != schedulers.end (); ++s)
+        {
+          ObjectFactory factory (*s);
+          Simulator::SetScheduler (factory);
+          bench->SetRandomStream (GetRandomStream (intervals));
 
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
+          std::cout << std::left << std::setw (swidth) << *s;
+          if (i < 0)
+            {
+              DEB ("priming");
+              std::cout << std::left << std::setw (g_fwidth) << "(prime)";
+              bench->RunBench ();
+            }
+          else
+            {
+              std::cout << std::left << std::setw (g_fwidth) << i;
+              times[*s].push_back (bench->RunBench ());
+            }
+        }
+    }
+
+  if (runs > 0)
     {
-      std::cout << std::setw (g_fwidth) << i;
+      LOG ("");
+      LOG (std::left << std::setw (swidth) << "Scheduler" <<
+           std::left << std::setw (g_fwidth) << "Median (s)" <<
+           std::left << std::setw (g_fwidth) << "Stdev (s)");
+      for (std::vector<std::string>::const_iterator s = schedulers.begin ();
+           s != schedulers.end (); ++s)
+        {
+          std::vector<double> &t = times[*s];
+          std::sort (t.begin (), t.end ());
+          double median = (t[(t.size () - 1) / 2] + t[t.size () / 2]) / 2;
 
-      bench->RunBench ();
+          double mean = 0;
+          for (std::size_t j = 0; j < t.size (); ++j)
+            {
+              mean += t[j];
+            }
+          mean /= t.size ();
+          double var = 0;
+          for (std::size_t j = 0; j < t.size (); ++j)
+            {
+              var += (t[j] - mean) * (t[j] - mean);
+            }
+          double stdev = t.size () > 1 ? std::sqrt (var / (t.size () - 1)) : 0;
+
+          LOG (std::left << std::setw (swidth) << *s <<
+               std::left << std::setw (g_fwidth) << median <<
+               std::left << std::setw (g_fwidth) << stdev);
+        }
     }
 
   LOG ("");
@@ -0,0 +1,79 @@
+#include "EventTraceScheduler.hpp"
+#include "ns3/abort.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+#include <iomanip>
+
+namespace ns3
+{
+    NS_OBJECT_ENSURE_REGISTERED(EventTraceScheduler);
+
+    TypeId
+    EventTraceScheduler::GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::EventTraceScheduler")
+                                .SetParent<Scheduler>()
+                                .AddConstructor<EventTraceScheduler>()
+                                .AddAttribute("Scheduler", "Type of the scheduler which keeps the events",
+                                              StringValue("ns3::MapScheduler"),
+                                              MakeStringAccessor(&EventTraceScheduler::m_schedulerType),
+                                              MakeStringChecker())
+                                .AddAttribute("FileName", "File to write the relative event times to, in seconds",
+                                              StringValue("event-trace.txt"),
+                                              MakeStringAccessor(&EventTraceScheduler::m_fileName),
+                                              MakeStringChecker());
+        return tid;
+    }
+
+    EventTraceScheduler::EventTraceScheduler()
+        : m_now(0)
+    {
+    }
+
+    EventTraceScheduler::~EventTraceScheduler() = default;
+
+    void
+    EventTraceScheduler::NotifyConstructionCompleted()
+    {
+        Scheduler::NotifyConstructionCompleted();
+
+        m_scheduler = ObjectFactory(m_schedulerType).Create<Scheduler>();
+        m_trace.open(m_fileName.c_str());
+        NS_ABORT_MSG_UNLESS(m_trace.is_open(), "Cannot open event trace " << m_fileName);
+        m_trace << std::fixed << std::setprecision(9);
+    }
+
+    void
+    EventTraceScheduler::Insert(const Event &ev)
+    {
+        m_trace << TimeStep(ev.key.m_ts - m_now).GetSeconds() << '\n';
+        m_scheduler->Insert(ev);
+    }
+
+    bool
+    EventTraceScheduler::IsEmpty() const
+    {
+        return m_scheduler->IsEmpty();
+    }
+
+    Scheduler::Event
+    EventTraceScheduler::PeekNext() const
+    {
+        return m_scheduler->PeekNext();
+    }
+
+    Scheduler::Event
+    EventTraceScheduler::RemoveNext()
+    {
+        Event ev = m_scheduler->RemoveNext();
+        m_now = ev.key.m_ts;
+        return ev;
+    }
+
+    void
+    EventTraceScheduler::Remove(const Event &ev)
+    {
+        m_scheduler->Remove(ev);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef SCENARIO_EVENT_TRACE_SCHEDULER_HPP
+#define SCENARIO_EVENT_TRACE_SCHEDULER_HPP
+
+#include "ns3/scheduler.h"
+#include "ns3/ptr.h"
+#include <fstream>
+#include <string>
+
+namespace ns3
+{
+    /** \brief scheduler that records the relative time of every inserted event
+     *
+     *  Events are kept by the scheduler named by the Scheduler attribute. For each inserted event, the
+     *  delay from the current simulation time is written to FileName in seconds, one per line, which is
+     *  the input format of bench-simulator --file. Any scenario can record its trace with
+     *
+     *    --SchedulerType=ns3::EventTraceScheduler --ns3::EventTraceScheduler::FileName=<file>
+     *
+     *  Only meant for the sequential simulator: every instance truncates the same file.
+     */
+    class EventTraceScheduler : public Scheduler
+    {
+    public:
+        static TypeId
+        GetTypeId();
+
+        EventTraceScheduler();
+
+        ~EventTraceScheduler() override;
+
+        void
+        Insert(const Event &ev) override;
+
+        bool
+        IsEmpty() const override;
+
+        Event
+        PeekNext() const override;
+
+        Event
+        RemoveNext() override;
+
+        void
+        Remove(const Event &ev) override;
+
+    protected:
+        void
+        NotifyConstructionCompleted() override;
+
+    private:
+        std::string m_schedulerType;
+        std::string m_fileName;
+        Ptr<Scheduler> m_scheduler;
+        std::ofstream m_trace;
+        uint64_t m_now; ///< timestamp of the last removed event, i.e. the current simulation time
+    };
+}
+
+#endif
@@ -0,0 +1,258 @@
+#include "OMCCRFStateTable.hpp"
+
+namespace nfd
+{
+    namespace fw
+    {
+        namespace omccrf
+        {
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////
+            //// AliasTable
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////
+            void
+            AliasTable::build(const FaceStates &faces)
+            {
+                size_t n = faces.size();
+                m_prob.resize(n);
+                m_alias.resize(n);
+
+                double totalWeight = 0;
+                for (const auto &face : faces)
+                {
+                    totalWeight += face.weight;
+                }
+
+                // scale weights so that their mean is 1, then pair each underfull column with an overfull one
+                boost::container::small_vector<uint32_t, 4> small;
+                boost::container::small_vector<uint32_t, 4> large;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    m_prob[i] = totalWeight > 0 ? faces[i].weight * n / totalWeight : 1.0;
+                    m_alias[i] = static_cast<uint32_t>(i);
+                    (m_prob[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+                }
+
+                while (!small.empty() && !large.empty())
+                {
+                    uint32_t s = small.back();
+                    small.pop_back();
+                    uint32_t l = large.back();
+
+                    m_alias[s] = l;
+                    m_prob[l] -= 1.0 - m_prob[s];
+                    if (m_prob[l] < 1.0)
+                    {
+                        large.pop_back();
+                        small.push_back(l);
+                    }
+                }
+
+                // leftovers are full columns, up to rounding error
+                for (uint32_t i : small)
+                {
+                    m_prob[i] = 1.0;
+                }
+                for (uint32_t i : large)
+                {
+                    m_prob[i] = 1.0;
+                }
+            }
+
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////
+            //// PrefixState
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////
+            constexpr uint32_t PrefixState::NO_POSITION;
+
+            PrefixState::PrefixState(const Name &prefix)
+                : m_prefix(prefix)
+            {
+            }
+
+            FaceState *
+            PrefixState::find(face::FaceId faceId)
+            {
+                for (auto &face : m_faces)
+                {
+                    if (face.faceId == faceId)
+                    {
+                        return &face;
+                    }
+                }
+                return nullptr;
+            }
+
+            void
+            PrefixState::erase(face::FaceId faceId)
+            {
+                FaceState *face = this->find(faceId);
+                if (face != nullptr)
+                {
+                    m_faces.erase(m_faces.begin() + (face - m_faces.data()));
+                    m_isSamplerStale = true;
+                    m_boundNexthops = nullptr;
+                }
+            }
+
+            FaceState &
+            PrefixState::get(face::FaceId faceId)
+            {
+                FaceState *face = this->find(faceId);
+                if (face != nullptr)
+                {
+                    return *face;
+                }
+                m_faces.push_back(FaceState{faceId, 0, 0.0, 1.0});
+                m_isSamplerStale = true;
+                m_boundNexthops = nullptr;
+                return m_faces.back();
+            }
+
+            bool
+            PrefixState::bind(const fib::NextHopList &nexthops, uint64_t version)
+            {
+                // next hops are only removed or reordered in place, which changes the size or is caught by
+                // sampleNextHop, while additions bump the version
+                if (m_boundNexthops == &nexthops && m_boundSize == nexthops.size() && m_boundVersion == version)
+                {
+                    return m_isCovered;
+                }
+
+                m_positions.assign(m_faces.size(), NO_POSITION);
+                size_t nCovered = 0;
+                for (uint32_t position = 0; position < nexthops.size(); ++position)
+                {
+                    FaceState *face = this->find(nexthops[position].getFace().getId());
+                    if (face != nullptr)
+                    {
+                        m_positions[face - m_faces.data()] = position;
+                        ++nCovered;
+                    }
+                }
+
+                m_boundNexthops = &nexthops;
+                m_boundSize = nexthops.size();
+                m_boundVersion = version;
+                m_isCovered = nCovered == nexthops.size();
+                return m_isCovered;
+            }
+
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////
+            //// StateTable
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////
+            constexpr size_t StateTable::UNLIMITED;
+            constexpr PrefixId StateTable::NONE;
+
+            PrefixId
+            StateTable::intern(const PrefixView &prefix)
+            {
+                size_t hash = prefix.hash();
+                auto now = time::steady_clock::now();
+
+                auto range = m_index.equal_range(hash);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    PrefixState &state = m_states[it->second];
+                    if (PrefixView(state.m_prefix) == prefix)
+                    {
+                        state.m_lastUsed = now;
+                        if (m_lruHead != it->second)
+                        {
+                            this->unlink(it->second);
+                            this->pushFront(it->second);
+                        }
+                        return it->second;
+                    }
+                }
+
+                if (m_limit != UNLIMITED && this->size() >= m_limit)
+                {
+                    this->evict(m_lruTail);
+                }
+
+                PrefixId id;
+                if (m_freeIds.empty())
+                {
+                    id = static_cast<PrefixId>(m_states.size());
+                    m_states.emplace_back(prefix.toName());
+                }
+                else
+                {
+                    id = m_freeIds.back();
+                    m_freeIds.pop_back();
+                    m_states[id] = PrefixState(prefix.toName());
+                }
+                m_states[id].m_hash = hash;
+                m_states[id].m_lastUsed = now;
+                m_index.emplace(hash, id);
+                this->pushFront(id);
+                return id;
+            }
+
+            void
+            StateTable::setLimit(size_t limit)
+            {
+                m_limit = limit;
+                while (m_limit != UNLIMITED && this->size() > m_limit)
+                {
+                    this->evict(m_lruTail);
+                }
+            }
+
+            void
+            StateTable::evictIdle(time::steady_clock::TimePoint cutoff)
+            {
+                while (m_lruTail != NONE && m_states[m_lruTail].m_lastUsed < cutoff)
+                {
+                    this->evict(m_lruTail);
+                }
+            }
+
+            void
+            StateTable::eraseFace(face::FaceId faceId)
+            {
+                for (auto &state : m_states)
+                {
+                    state.erase(faceId);
+                }
+            }
+
+            void
+            StateTable::unlink(PrefixId id)
+            {
+                PrefixState &state = m_states[id];
+                (state.m_lruPrev == NONE ? m_lruHead : m_states[state.m_lruPrev].m_lruNext) = state.m_lruNext;
+                (state.m_lruNext == NONE ? m_lruTail : m_states[state.m_lruNext].m_lruPrev) = state.m_lruPrev;
+            }
+
+            void
+            StateTable::pushFront(PrefixId id)
+            {
+                PrefixState &state = m_states[id];
+                state.m_lruPrev = NONE;
+                state.m_lruNext = m_lruHead;
+                (m_lruHead == NONE ? m_lruTail : m_states[m_lruHead].m_lruPrev) = id;
+                m_lruHead = id;
+            }
+
+            void
+            StateTable::evict(PrefixId id)
+            {
+                this->unlink(id);
+
+                auto range = m_index.equal_range(m_states[id].m_hash);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (it->second == id)
+                    {
+                        m_index.erase(it);
+                        break;
+                    }
+                }
+
+                // keep the slot so that other ids stay valid, but release its prefix and face records
+                m_states[id] = PrefixState(Name());
+                m_freeIds.push_back(id);
+            }
+        }
+    }
+}
@@ -0,0 +1,309 @@
+#ifndef NFD_DAEMON_FW_OMCCRF_STATE_TABLE_HPP
+#define NFD_DAEMON_FW_OMCCRF_STATE_TABLE_HPP
+
+#include "face/face.hpp"
+#include "table/fib-entry.hpp"
+#include <boost/container/small_vector.hpp>
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace nfd
+{
+    namespace fw
+    {
+        namespace omccrf
+        {
+            /** \brief path-interest accounting of one upstream face under one prefix
+             */
+            struct FaceState
+            {
+                face::FaceId faceId;
+                uint64_t PI;
+                double avgPI;
+                double weight;
+            };
+
+            using FaceStates = boost::container::small_vector<FaceState, 4>;
+
+            /** \brief Vose alias table drawing a face record index proportionally to its weight in O(1)
+             */
+            class AliasTable
+            {
+            public:
+                /** \brief rebuild the table from the weights of \p faces
+                 */
+                void
+                build(const FaceStates &faces);
+
+                /** \return index of the drawn face record
+                 *  \pre the table was built from a non-empty set of faces
+                 */
+                template <typename Rng>
+                size_t
+                sample(Rng &rng) const
+                {
+                    size_t column = boost::random::uniform_int_distribution<size_t>(0, m_prob.size() - 1)(rng);
+                    return boost::random::uniform_01<double>()(rng) < m_prob[column] ? column : m_alias[column];
+                }
+
+            private:
+                boost::container::small_vector<double, 4> m_prob;
+                boost::container::small_vector<uint32_t, 4> m_alias;
+            };
+
+            /** \brief identifies an interned prefix within a StateTable
+             */
+            using PrefixId = uint32_t;
+
+            /// PrefixId that identifies no prefix
+            constexpr PrefixId INVALID_PREFIX_ID = std::numeric_limits<PrefixId>::max();
+
+            /** \brief per-prefix state: a contiguous array of face records
+             *
+             *  Most prefixes have only a handful of upstream faces, so the records are kept inline
+             *  and looked up by linear scan. The alias table over their weights is rebuilt lazily,
+             *  on the first draw after a weight has changed or a face has been added.
+             */
+            class PrefixState
+            {
+            public:
+                explicit PrefixState(const Name &prefix);
+
+                /** \return record of \p faceId, or nullptr if the face has not been seen under this prefix
+                 */
+                FaceState *
+                find(face::FaceId faceId);
+
+                /** \brief erase the record of \p faceId, if any
+                 */
+                void
+                erase(face::FaceId faceId);
+
+                /** \brief find or insert the record of \p faceId
+                 *
+                 *  A new record starts with PI = 0, avgPI = 0 and weight = 1.
+                 *  Inserting may invalidate references to other records of this prefix.
+                 */
+                FaceState &
+                get(face::FaceId faceId);
+
+                /** \brief map the records to their positions in \p nexthops
+                 *  \param version must change whenever a next hop is added to any FIB entry
+                 *  \return whether every face in \p nexthops has a record under this prefix
+                 *
+                 *  Records may also exist for faces that are not in \p nexthops, e.g. when several FIB
+                 *  entries share this prefix, so the number of records alone does not tell. The mapping is
+                 *  kept until a record is added or removed, or other next hops are bound, so that binding
+                 *  the same FIB entry on every Interest is O(1).
+                 */
+                bool
+                bind(const fib::NextHopList &nexthops, uint64_t version);
+
+                const Name &
+                getPrefix() const
+                {
+                    return m_prefix;
+                }
+
+                FaceStates &
+                getFaces()
+                {
+                    return m_faces;
+                }
+
+                /** \return when the prefix was last looked up
+                 */
+                time::steady_clock::TimePoint
+                getLastUsed() const
+                {
+                    return m_lastUsed;
+                }
+
+                /** \brief mark the alias table stale after a weight has changed
+                 */
+                void
+                invalidateSampler()
+                {
+                    m_isSamplerStale = true;
+                }
+
+                /** \brief draw a face record proportionally to its weight
+                 *  \pre getFaces() is not empty
+                 */
+                template <typename Rng>
+                FaceState &
+                sample(Rng &rng)
+                {
+                    return m_faces[this->sampleIndex(rng)];
+                }
+
+                /** \brief draw a next hop proportionally to the weight of its record
+                 *  \pre bind(nexthops) returned true and getFaces() is not empty
+                 *  \return the drawn next hop, or nullptr if the drawn record is not one of \p nexthops
+                 *
+                 *  A FIB entry reorders its next hops when a cost changes. A draw that finds another face
+                 *  at the bound position returns nullptr and drops the mapping, so the next bind() redoes it.
+                 */
+                template <typename Rng>
+                const fib::NextHop *
+                sampleNextHop(Rng &rng, const fib::NextHopList &nexthops)
+                {
+                    size_t index = this->sampleIndex(rng);
+                    uint32_t position = m_positions[index];
+                    if (position == NO_POSITION)
+                    {
+                        return nullptr;
+                    }
+                    if (nexthops[position].getFace().getId() != m_faces[index].faceId)
+                    {
+                        m_boundNexthops = nullptr;
+                        return nullptr;
+                    }
+                    return &nexthops[position];
+                }
+
+            private:
+                template <typename Rng>
+                size_t
+                sampleIndex(Rng &rng)
+                {
+                    if (m_isSamplerStale)
+                    {
+                        m_sampler.build(m_faces);
+                        m_isSamplerStale = false;
+                    }
+                    return m_sampler.sample(rng);
+                }
+
+            private:
+                /// position of a record whose face is not among the bound next hops
+                static constexpr uint32_t NO_POSITION = std::numeric_limits<uint32_t>::max();
+
+                Name m_prefix;
+                FaceStates m_faces;
+                AliasTable m_sampler;
+                bool m_isSamplerStale = true;
+
+                // next hops the records were last bound to, and the position of each record in them
+                const fib::NextHopList *m_boundNexthops = nullptr;
+                size_t m_boundSize = 0;
+                uint64_t m_boundVersion = 0;
+                bool m_isCovered = false;
+                boost::container::small_vector<uint32_t, 4> m_positions;
+
+                // bookkeeping of StateTable
+                size_t m_hash = 0;
+                time::steady_clock::TimePoint m_lastUsed;
+                PrefixId m_lruPrev = INVALID_PREFIX_ID;
+                PrefixId m_lruNext = INVALID_PREFIX_ID;
+
+                friend class StateTable;
+            };
+
+            /** \brief OMCCRF per-prefix/per-face state table
+             *
+             *  Prefixes are interned once into dense PrefixIds. Lookups take a PrefixView of the packet
+             *  name, which is hashed and compared against the interned prefix in place, so no Name or
+             *  string is built on the per-packet path.
+             *
+             *  The table keeps its prefixes in least-recently-used order. When a limit is set, interning a
+             *  new prefix into a full table evicts the least recently used one, and evictIdle drops prefixes
+             *  that have not been looked up for a while. The ids of evicted prefixes are reused; their slots
+             *  stay in place with no face records.
+             */
+            class StateTable
+            {
+            public:
+                /// no limit on the number of tracked prefixes
+                static constexpr size_t UNLIMITED = 0;
+
+                /** \brief set the maximum number of tracked prefixes, evicting the least recently used ones
+                 */
+                void
+                setLimit(size_t limit);
+
+                size_t
+                getLimit() const
+                {
+                    return m_limit;
+                }
+
+                /** \brief evict all prefixes not looked up since \p cutoff
+                 */
+                void
+                evictIdle(time::steady_clock::TimePoint cutoff);
+
+                /** \brief erase the records of \p faceId from every prefix
+                 */
+                void
+                eraseFace(face::FaceId faceId);
+
+                /** \brief find or intern the prefix viewed by \p prefix
+                 *  \return id of the interned prefix, now the most recently used one
+                 */
+                PrefixId
+                intern(const PrefixView &prefix);
+
+                /** \brief find or intern the prefix, then return its state
+                 *  \note The reference is invalidated when another prefix is interned or evicted.
+                 */
+                PrefixState &
+                lookup(const PrefixView &prefix)
+                {
+                    return m_states[this->intern(prefix)];
+                }
+
+                PrefixState &
+                operator[](PrefixId id)
+                {
+                    return m_states[id];
+                }
+
+                /** \return number of tracked prefixes
+                 */
+                size_t
+                size() const
+                {
+                    return m_states.size() - m_freeIds.size();
+                }
+
+                std::vector<PrefixState>::iterator
+                begin()
+                {
+                    return m_states.begin();
+                }
+
+                std::vector<PrefixState>::iterator
+                end()
+                {
+                    return m_states.end();
+                }
+
+            private:
+                void
+                unlink(PrefixId id);
+
+                void
+                pushFront(PrefixId id);
+
+                void
+                evict(PrefixId id);
+
+            private:
+                static constexpr PrefixId NONE = INVALID_PREFIX_ID;
+
+                std::vector<PrefixState> m_states;
+                std::vector<PrefixId> m_freeIds;
+                std::unordered_multimap<size_t, PrefixId> m_index;
+                PrefixId m_lruHead = NONE; ///< most recently used
+                PrefixId m_lruTail = NONE; ///< least recently used
+                size_t m_limit = UNLIMITED;
+            };
+        }
+    }
+}
+
+#endif
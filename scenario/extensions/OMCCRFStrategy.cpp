@@ -1,5 +1,10 @@
 #include "OMCCRFStrategy.hpp"
+#include "common/global.hpp"
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/lp/route-label.hpp>
+#include <boost/random/uniform_01.hpp>
+#include "ns3/rng-seed-manager.h"
+#include <random>
 
 NFD_LOG_INIT(OMCCRFStrategy);
 
@@ -12,13 +17,48 @@ namespace nfd
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         const time::milliseconds OMCCRFStrategy::RETX_SUPPRESSION_INITIAL(10);
         const time::milliseconds OMCCRFStrategy::RETX_SUPPRESSION_MAX(250);
+        const int OMCCRFStrategy::MAX_SAMPLING_ATTEMPTS = 4;
 
         OMCCRFStrategy::OMCCRFStrategy(nfd::Forwarder &forwarder, const ndn::Name &name)
             : Strategy(forwarder), ProcessNackTraits<OMCCRFStrategy>(this), m_retxSuppression(RETX_SUPPRESSION_INITIAL,
                                                                                               RetxSuppressionExponential::DEFAULT_MULTIPLIER,
                                                                                               RETX_SUPPRESSION_MAX)
         {
+            ParsedInstanceName parsed = parseInstanceName(name);
+            if (!parsed.parameters.empty())
+            {
+                this->processParams(parsed.parameters);
+            }
+
+            if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion())
+            {
+                NDN_THROW(std::invalid_argument(
+                    "OMCCRFStrategy does not support version " + to_string(*parsed.version)));
+            }
             this->setInstanceName(makeInstanceName(name, getStrategyName()));
+
+            // every instance takes its own ns-3 stream index, so runs are reproducible for a given seed and run
+            uint64_t run = ns3::RngSeedManager::GetRun();
+            uint64_t stream = ns3::RngSeedManager::GetNextStreamIndex();
+            std::seed_seq seeds{ns3::RngSeedManager::GetSeed(),
+                                static_cast<uint32_t>(run), static_cast<uint32_t>(run >> 32),
+                                static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+            this->rng.seed(seeds);
+
+            if (this->idleTimeout > 0_ms)
+            {
+                this->idleTimer = getScheduler().schedule(this->idleTimeout, [this] { evictIdlePrefixes(); });
+            }
+
+            this->removeFaceConn = this->beforeRemoveFace.connect([this](const Face &face)
+                                                                  { this->states.eraseFace(face.getId()); });
+            this->newNextHopConn = forwarder.getFib().afterNewNextHop.connect([this](const Name &, const fib::NextHop &)
+                                                                              { ++this->fibVersion; });
+
+            NFD_LOG_DEBUG("prefix-length=" << (useFibPrefix ? "fib" : to_string(prefixLength))
+                                           << " ewma-interval=" << ewmaInterval
+                                           << " max-prefixes=" << states.getLimit()
+                                           << " idle-timeout=" << idleTimeout);
         }
 
         const Name &
@@ -28,6 +68,67 @@ namespace nfd
             return strategyName;
         }
 
+        static uint64_t
+        getParamValue(const std::string &param, const std::string &value)
+        {
+            try
+            {
+                if (value.empty() || value[0] == '-')
+                {
+                    NDN_THROW(boost::bad_lexical_cast());
+                }
+                return boost::lexical_cast<uint64_t>(value);
+            }
+            catch (const boost::bad_lexical_cast &)
+            {
+                NDN_THROW(std::invalid_argument("Value of " + param + " must be a non-negative integer"));
+            }
+        }
+
+        void
+        OMCCRFStrategy::processParams(const PartialName &parsed)
+        {
+            for (const auto &component : parsed)
+            {
+                std::string parsedStr(reinterpret_cast<const char *>(component.value()), component.value_size());
+                auto n = parsedStr.find("~");
+                if (n == std::string::npos)
+                {
+                    NDN_THROW(std::invalid_argument("Format is <parameter>~<value>"));
+                }
+
+                auto f = parsedStr.substr(0, n);
+                auto s = parsedStr.substr(n + 1);
+                if (f == "prefix-length")
+                {
+                    if (s == "fib")
+                    {
+                        this->useFibPrefix = true;
+                        continue;
+                    }
+                    this->prefixLength = getParamValue(f, s);
+                    this->useFibPrefix = false;
+                }
+                else if (f == "ewma-interval")
+                {
+                    this->ewmaInterval = time::milliseconds(getParamValue(f, s));
+                }
+                else if (f == "max-prefixes")
+                {
+                    this->states.setLimit(getParamValue(f, s));
+                }
+                else if (f == "idle-timeout")
+                {
+                    this->idleTimeout = time::milliseconds(getParamValue(f, s));
+                }
+                else
+                {
+                    NDN_THROW(std::invalid_argument(
+                        "Parameter should be prefix-length, ewma-interval, max-prefixes or idle-timeout"));
+                }
+            }
+        }
+
         void
         OMCCRFStrategy::afterReceiveInterest(const nfd::FaceEndpoint &ingress, const ndn::Interest &interest,
                                              const std::shared_ptr<nfd::pit::Entry> &pitEntry)
@@ -45,7 +146,7 @@ namespace nfd
 
             Face *outFace = nullptr;
 
-            std::string prefix = interest.getName().getPrefix(1).toUri();
+            omccrf::PrefixState &state = this->lookupState(interest.getName(), fibEntry);
 
             if (ingress.face.getScope() != ndn::nfd::FACE_SCOPE_NON_LOCAL)
             {
@@ -58,45 +159,11 @@ namespace nfd
             }
             else
             {
-                double r = ((double)rand() / (RAND_MAX));
-
-                double totalWeight = 0;
-
-                // Add all eligbile faces to list (excludes current downstream)
-                std::vector<Face *> eligbleFaces;
-                for (auto &n : fibEntry.getNextHops())
-                {
-                    if (isNextHopEligible(ingress.face, interest, n, pitEntry))
-                    {
-                        // Add up percentage Sum.
-                        auto faceId = n.getFace().getId();
-                        this->ensureAvgPIsAndWeights(prefix, faceId);
-                        totalWeight += (*this->weights[prefix])[faceId];
-                        eligbleFaces.push_back(&n.getFace());
-                    }
-                }
-
-                if (eligbleFaces.size() < 1)
+                outFace = this->selectNextHop(state, ingress.face, interest, fibEntry, pitEntry);
+                if (outFace == nullptr)
                 {
                     return;
                 }
-                else if (eligbleFaces.size() == 1)
-                {
-                    outFace = eligbleFaces.front();
-                }
-                else
-                {
-                    double forwPerc = 0;
-                    for (auto face : eligbleFaces)
-                    {
-                        forwPerc += ((*this->weights[prefix])[face->getId()] / totalWeight);
-                        if (r < forwPerc)
-                        {
-                            outFace = face;
-                            break;
-                        }
-                    }
-                }
             }
 
             if (outFace == nullptr)
@@ -109,8 +176,9 @@ namespace nfd
             }
             else
             {
-                this->increasePI(prefix, outFace->getId());
-                this->fibWeightUpdate(outFace->getId(), prefix);
+                omccrf::FaceState &face = state.get(outFace->getId());
+                this->increasePI(face);
+                this->fibWeightUpdate(state, face);
 
                 this->sendInterest(pitEntry, FaceEndpoint(*outFace, 0), interest);
             }
@@ -120,23 +188,18 @@ namespace nfd
         OMCCRFStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry> &pitEntry,
                                               const FaceEndpoint &ingress, const Data &data)
         {
-            std::string prefix = data.getName().getPrefix(1).toUri();
-            this->decreasePI(prefix, ingress.face.getId());
+            omccrf::PrefixState &state = this->lookupState(data.getName(), *pitEntry);
+            omccrf::FaceState &face = state.get(ingress.face.getId());
+            this->decreasePI(face);
 
-            this->fibWeightUpdate(ingress.face.getId(), prefix);
+            this->fibWeightUpdate(state, face);
 
             if (ingress.face.getId() > 256)
             {
                 auto routeLabel = data.getTag<lp::RouteLabelTag>();
-                uint64_t newRouteLabelValue = 0;
-                if (routeLabel == nullptr)
-                {
-                    newRouteLabelValue = ingress.face.getId() - 256;
-                }
-                else
-                {
-                    newRouteLabelValue = routeLabel->get() * 10 + (ingress.face.getId() - 256);
-                }
+                uint64_t newRouteLabelValue = lp::route_label::appendHop(
+                    routeLabel == nullptr ? lp::route_label::EMPTY : routeLabel->get(),
+                    ingress.face.getId() - 256);
                 data.setTag(make_shared<lp::RouteLabelTag>(newRouteLabelValue));
             }
         }
@@ -151,81 +214,175 @@ namespace nfd
         void
         OMCCRFStrategy::afterPITExpire(const shared_ptr<pit::Entry> &pitEntry)
         {
-            std::string prefix = pitEntry->getName().getPrefix(1).toUri();
+            omccrf::PrefixState &state = this->lookupState(pitEntry->getName(), *pitEntry);
 
             for (auto &outRecord : pitEntry->getOutRecords())
             {
-                this->decreasePI(prefix, outRecord.getFace().getId());
+                omccrf::FaceState &face = state.get(outRecord.getFace().getId());
+                this->decreasePI(face);
 
-                this->fibWeightUpdate(outRecord.getFace().getId(), prefix);
+                this->fibWeightUpdate(state, face);
             }
         }
 
-        void
-        OMCCRFStrategy::ensurePI(const std::string &prefix, face::FaceId faceId)
+        Face *
+        OMCCRFStrategy::selectNextHop(omccrf::PrefixState &state, const Face &inFace, const Interest &interest,
+                                      const fib::Entry &fibEntry, const shared_ptr<pit::Entry> &pitEntry)
         {
-            if (this->PIs.count(prefix) == 0)
+            const fib::NextHopList &nexthops = fibEntry.getNextHops();
+
+            // Draw from the alias table and reject faces that are not eligible. This is only done once
+            // every next hop has a record, otherwise next hops not seen yet could never be drawn.
+            if (!nexthops.empty())
+            {
+                for (int i = 0; i < MAX_SAMPLING_ATTEMPTS && state.bind(nexthops, this->fibVersion); ++i)
+                {
+                    const fib::NextHop *nexthop = state.sampleNextHop(this->rng, nexthops);
+                    if (nexthop != nullptr && isNextHopEligible(inFace, interest, *nexthop, pitEntry))
+                    {
+                        return &nexthop->getFace();
+                    }
+                }
+            }
+
+            double r = boost::random::uniform_01<double>()(this->rng);
+
+            double totalWeight = 0;
+
+            // Add all eligbile faces to list (excludes current downstream), together with their weights
+            boost::container::small_vector<std::pair<Face *, double>, 8> eligbleFaces;
+            for (auto &n : nexthops)
+            {
+                if (isNextHopEligible(inFace, interest, n, pitEntry))
+                {
+                    // Add up percentage Sum. A next hop without a record has the weight of a new one.
+                    const omccrf::FaceState *face = state.find(n.getFace().getId());
+                    double weight = face != nullptr ? face->weight : 1.0;
+                    totalWeight += weight;
+                    eligbleFaces.emplace_back(&n.getFace(), weight);
+                }
+            }
+
+            if (eligbleFaces.size() < 1)
             {
-                this->PIs[prefix] = std::make_shared<std::unordered_map<face::FaceId, uint64_t>>();
+                return nullptr;
             }
-            if (this->PIs[prefix]->count(faceId) == 0)
+            else if (eligbleFaces.size() == 1)
             {
-                (*this->PIs[prefix])[faceId] = 0;
+                return eligbleFaces.front().first;
             }
+
+            double forwPerc = 0;
+            for (const auto &face : eligbleFaces)
+            {
+                forwPerc += (face.second / totalWeight);
+                if (r < forwPerc)
+                {
+                    return face.first;
+                }
+            }
+            // r fell past the last cumulative share by rounding
+            return eligbleFaces.back().first;
         }
 
-        void
-        OMCCRFStrategy::increasePI(const std::string &prefix, face::FaceId faceId)
+        omccrf::PrefixState &
+        OMCCRFStrategy::lookupState(const Name &name, const fib::Entry &fibEntry)
         {
-            this->ensurePI(prefix, faceId);
-            (*this->PIs[prefix])[faceId]++;
+            if (this->useFibPrefix)
+            {
+                return this->lookupState(fibEntry.getPrefix());
+            }
+            return this->lookupState(PrefixView(name, this->prefixLength));
+        }
+
+        omccrf::PrefixState &
+        OMCCRFStrategy::lookupState(const Name &name, const pit::Entry &pitEntry)
+        {
+            if (this->useFibPrefix)
+            {
+                return this->lookupState(name, this->lookupFib(pitEntry));
+            }
+            return this->lookupState(PrefixView(name, this->prefixLength));
+        }
+
+        omccrf::PrefixState &
+        OMCCRFStrategy::lookupState(const PrefixView &prefix)
+        {
+            // the batch timer only runs while some prefix is tracked
+            if (this->ewmaInterval > 0_ms && !this->ewmaTimer)
+            {
+                this->ewmaTimer = getScheduler().schedule(this->ewmaInterval, [this] { periodicWeightUpdate(); });
+            }
+            return this->states.lookup(prefix);
         }
 
         void
-        OMCCRFStrategy::decreasePI(const std::string &prefix, face::FaceId faceId)
+        OMCCRFStrategy::increasePI(omccrf::FaceState &face)
         {
-            this->ensurePI(prefix, faceId);
-            (*this->PIs[prefix])[faceId]--;
+            face.PI++;
         }
 
         void
-        OMCCRFStrategy::ensureAvgPIsAndWeights(const std::string &prefix, face::FaceId faceId)
+        OMCCRFStrategy::decreasePI(omccrf::FaceState &face)
         {
-            // ensure avgPIs
-            if (this->avgPIs.count(prefix) == 0)
+            // a Data or expiry may arrive for a face whose Interest was accounted before the record existed
+            if (face.PI > 0)
             {
-                this->avgPIs[prefix] = std::make_shared<std::unordered_map<face::FaceId, double>>();
+                face.PI--;
             }
-            if (this->avgPIs[prefix]->count(faceId) == 0)
+        }
+
+        void
+        OMCCRFStrategy::fibWeightUpdate(omccrf::PrefixState &state, omccrf::FaceState &face)
+        {
+            // in batch mode the timer smooths all faces, packets only move PI
+            if (this->ewmaInterval == 0_ms)
             {
-                (*this->avgPIs[prefix])[faceId] = 0.0;
+                this->applyEwma(state, face);
             }
+        }
+
+        void
+        OMCCRFStrategy::applyEwma(omccrf::PrefixState &state, omccrf::FaceState &face)
+        {
+            face.avgPI = alpha * face.avgPI + (1 - alpha) * face.PI;
 
-            // ensure weights
-            if (this->weights.count(prefix) == 0)
+            double avgPI = face.avgPI;
+            if (avgPI < 1)
             {
-                this->weights[prefix] = std::make_shared<std::unordered_map<face::FaceId, double>>();
+                avgPI = 1;
             }
-            if (this->weights[prefix]->count(faceId) == 0)
+            if (face.weight != 1.0 / avgPI)
             {
-                (*this->weights[prefix])[faceId] = 1.0;
+                face.weight = 1.0 / avgPI;
+                state.invalidateSampler();
             }
         }
 
         void
-        OMCCRFStrategy::fibWeightUpdate(const face::FaceId &faceId, const std::string &prefix)
+        OMCCRFStrategy::periodicWeightUpdate()
         {
-            this->ensureAvgPIsAndWeights(prefix, faceId);
-
-            (*this->avgPIs[prefix])[faceId] = alpha * (*this->avgPIs[prefix])[faceId] + (1 - alpha) *
-                                                                                            (*this->PIs[prefix])[faceId];
+            for (auto &state : this->states)
+            {
+                for (auto &face : state.getFaces())
+                {
+                    this->applyEwma(state, face);
+                }
+            }
 
-            double avgPI = (*this->avgPIs[prefix])[faceId];
-            if (avgPI < 1)
+            // once every prefix has been evicted, the next lookupState restarts the timer
+            if (this->states.size() > 0)
             {
-                avgPI = 1;
+                this->ewmaTimer = getScheduler().schedule(this->ewmaInterval, [this] { periodicWeightUpdate(); });
             }
-            (*this->weights[prefix])[faceId] = 1.0 / avgPI;
+        }
+
+        void
+        OMCCRFStrategy::evictIdlePrefixes()
+        {
+            this->states.evictIdle(time::steady_clock::now() - this->idleTimeout);
+
+            this->idleTimer = getScheduler().schedule(this->idleTimeout, [this] { evictIdlePrefixes(); });
         }
     }
 }
\ No newline at end of file
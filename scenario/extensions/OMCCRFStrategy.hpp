@@ -7,14 +7,27 @@
 #include "fw/retx-suppression-exponential.hpp"
 #include "fw/algorithm.hpp"
 #include "fw/process-nack-traits.hpp"
-#include <unordered_map>
-#include <string>
+#include "OMCCRFStateTable.hpp"
 #include <limits>
 
 namespace nfd
 {
     namespace fw
     {
+        /** \brief OMCCRF forwarding strategy
+         *
+         *  Pending Interests are accounted per prefix and per upstream face. The accounting prefix is
+         *  selected by the strategy parameter <tt>prefix-length~\<n\></tt> (the first n name components,
+         *  default 1), or <tt>prefix-length~fib</tt> to aggregate under the FIB entry the Interest matched.
+         *
+         *  By default avgPI is smoothed on every Interest, Data and PIT expiry. With
+         *  <tt>ewma-interval~\<ms\></tt> it is instead smoothed for all faces once per interval, so that
+         *  the smoothing horizon no longer depends on the packet rate and packets only adjust PI.
+         *
+         *  State of faces is dropped when they are removed from the face table. <tt>max-prefixes~\<n\></tt>
+         *  caps the number of tracked prefixes with LRU eviction, and <tt>idle-timeout~\<ms\></tt> expires
+         *  prefixes that have seen no packet for that long. Both are disabled by default.
+         */
         class OMCCRFStrategy : public Strategy, public ProcessNackTraits<OMCCRFStrategy>
         {
         public:
@@ -35,37 +48,89 @@ namespace nfd
                              const shared_ptr<pit::Entry> &pitEntry) override;
 
             void
-            afterPITExpire(const shared_ptr<pit::Entry> &pitEntry);
+            afterPITExpire(const shared_ptr<pit::Entry> &pitEntry) override;
 
             static const Name &
             getStrategyName();
 
         protected:
-            void ensurePI(const std::string& prefix, face::FaceId faceId);
+            void increasePI(omccrf::FaceState &face);
 
-            void ensureAvgPIsAndWeights(const std::string& prefix, face::FaceId faceId);
+            void decreasePI(omccrf::FaceState &face);
 
-            void increasePI(const std::string& prefix, face::FaceId faceId);
+            void fibWeightUpdate(omccrf::PrefixState &state, omccrf::FaceState &face);
 
-            void decreasePI(const std::string& prefix, face::FaceId faceId);
+            /** \brief smooth avgPI of \p face and derive its weight
+             */
+            void applyEwma(omccrf::PrefixState &state, omccrf::FaceState &face);
 
-            void fibWeightUpdate(const face::FaceId &faceId, const std::string &prefix);
+            /** \brief smooth all faces of all prefixes, then reschedule itself while any prefix is tracked
+             */
+            void periodicWeightUpdate();
+
+            /** \brief expire idle prefixes, then reschedule itself
+             */
+            void evictIdlePrefixes();
+
+            /** \brief pick an eligible next hop proportionally to the weights of \p state
+             *  \return the selected face, or nullptr if no next hop is eligible
+             */
+            Face *selectNextHop(omccrf::PrefixState &state, const Face &inFace, const Interest &interest,
+                                const fib::Entry &fibEntry, const shared_ptr<pit::Entry> &pitEntry);
+
+            /** \return state of the prefix under which \p name is accounted, given its matched \p fibEntry
+             */
+            omccrf::PrefixState &lookupState(const Name &name, const fib::Entry &fibEntry);
+
+            /** \return state of the prefix under which \p name is accounted, given its \p pitEntry
+             */
+            omccrf::PrefixState &lookupState(const Name &name, const pit::Entry &pitEntry);
+
+            /** \return state of \p prefix, starting the batch weight update timer if it is stopped
+             */
+            omccrf::PrefixState &lookupState(const PrefixView &prefix);
+
+        private:
+            void processParams(const PartialName &parsed);
 
         protected:
             friend ProcessNackTraits<OMCCRFStrategy>;
 
         protected:
-            std::unordered_map<std::string, std::shared_ptr<std::unordered_map<face::FaceId, uint64_t>>> PIs;
+            omccrf::StateTable states;
 
-            std::unordered_map<std::string, std::shared_ptr<std::unordered_map<face::FaceId, double>>> avgPIs;
+            double alpha = 0.9;
 
-            std::unordered_map<std::string, std::shared_ptr<std::unordered_map<face::FaceId, double>>> weights;
+            /// number of leading name components used as the accounting key
+            size_t prefixLength = 1;
 
-            double alpha = 0.9;
+            /// whether to account under the matched FIB prefix instead of a fixed number of components
+            bool useFibPrefix = false;
+
+            /// interval between batch weight updates; zero updates on every packet
+            time::milliseconds ewmaInterval = 0_ms;
+
+            scheduler::ScopedEventId ewmaTimer;
+
+            /// prefixes not looked up for this long are expired; zero keeps them forever
+            time::milliseconds idleTimeout = 0_ms;
+
+            scheduler::ScopedEventId idleTimer;
+
+            signal::ScopedConnection removeFaceConn;
+
+            /// bumped whenever a next hop is added to the FIB, so that PrefixState::bind sees the change
+            uint64_t fibVersion = 0;
+
+            signal::ScopedConnection newNextHopConn;
+
+            /// per-strategy engine for next hop selection, seeded from ns3::RngSeedManager
+            boost::random::mt19937 rng;
 
         private:
             static const time::milliseconds RETX_SUPPRESSION_INITIAL;
             static const time::milliseconds RETX_SUPPRESSION_MAX;
+            static const int MAX_SAMPLING_ATTEMPTS;
             RetxSuppressionExponential m_retxSuppression;
         };
     }
@@ -0,0 +1,4 @@
+#define BOOST_TEST_MODULE scenario extensions
+
+// header-only Boost.Test, so the tests need nothing beyond the libraries the scenarios link
+#include <boost/test/included/unit_test.hpp>
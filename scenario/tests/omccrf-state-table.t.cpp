@@ -0,0 +1,270 @@
+#include "OMCCRFStateTable.hpp"
+#include "face/null-face.hpp"
+
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace nfd
+{
+    namespace fw
+    {
+        namespace omccrf
+        {
+            namespace tests
+            {
+                BOOST_AUTO_TEST_SUITE(OMCCRFStateTable)
+
+                BOOST_AUTO_TEST_CASE(BindSharedState)
+                {
+                    auto face1 = face::makeNullFace();
+                    auto face2 = face::makeNullFace();
+                    auto face3 = face::makeNullFace();
+                    face1->setId(301);
+                    face2->setId(302);
+                    face3->setId(303);
+
+                    // two FIB entries aggregated under one prefix: /A via face1 and face2, /B via face3
+                    PrefixState state("/A");
+                    fib::NextHopList nexthopsA{fib::NextHop(*face1), fib::NextHop(*face2)};
+                    fib::NextHopList nexthopsB{fib::NextHop(*face3)};
+
+                    // face2 has no record, but as many records as next hops of /A exist
+                    state.get(301);
+                    state.get(303);
+                    BOOST_CHECK_EQUAL(state.getFaces().size(), nexthopsA.size());
+                    BOOST_CHECK(!state.bind(nexthopsA, 0));
+                    BOOST_CHECK(state.bind(nexthopsB, 0));
+
+                    state.get(302);
+                    BOOST_CHECK(state.bind(nexthopsA, 0));
+
+                    state.erase(301);
+                    BOOST_CHECK(!state.bind(nexthopsA, 0));
+                    BOOST_CHECK(state.bind(fib::NextHopList{}, 0));
+                }
+
+                BOOST_AUTO_TEST_CASE(BindNewNextHop)
+                {
+                    auto face1 = face::makeNullFace();
+                    auto face2 = face::makeNullFace();
+                    face1->setId(301);
+                    face2->setId(302);
+
+                    PrefixState state("/A");
+                    state.get(301);
+
+                    fib::NextHopList nexthops{fib::NextHop(*face1)};
+                    BOOST_CHECK(state.bind(nexthops, 0));
+
+                    // face2 replaces face1 in place, which only the version tells
+                    nexthops.front() = fib::NextHop(*face2);
+                    BOOST_CHECK(!state.bind(nexthops, 1));
+
+                    state.get(302);
+                    BOOST_CHECK(state.bind(nexthops, 1));
+                    boost::random::mt19937 rng;
+                    for (int i = 0; i < 100; ++i)
+                    {
+                        const fib::NextHop *nexthop = state.sampleNextHop(rng, nexthops);
+                        BOOST_CHECK(nexthop == nullptr || nexthop == &nexthops.front());
+                    }
+                }
+
+                BOOST_AUTO_TEST_CASE(SampleReorderedNextHops)
+                {
+                    auto face1 = face::makeNullFace();
+                    auto face2 = face::makeNullFace();
+                    face1->setId(301);
+                    face2->setId(302);
+
+                    PrefixState state("/A");
+                    state.get(301).weight = 1.0;
+                    state.get(302).weight = 0.0;
+
+                    fib::NextHopList nexthops{fib::NextHop(*face1), fib::NextHop(*face2)};
+                    BOOST_REQUIRE(state.bind(nexthops, 0));
+                    boost::random::mt19937 rng;
+                    BOOST_CHECK(state.sampleNextHop(rng, nexthops) == &nexthops[0]);
+
+                    // a cost change reorders the next hops in place: the stale draw is rejected and rebinding
+                    // finds face1 at its new position
+                    std::swap(nexthops[0], nexthops[1]);
+                    BOOST_CHECK(state.sampleNextHop(rng, nexthops) == nullptr);
+                    BOOST_REQUIRE(state.bind(nexthops, 0));
+                    BOOST_CHECK(state.sampleNextHop(rng, nexthops) == &nexthops[1]);
+                }
+
+                class ClockFixture
+                {
+                public:
+                    ClockFixture()
+                        : clock(make_shared<time::UnitTestSteadyClock>())
+                    {
+                        time::setCustomClocks(clock, nullptr);
+                    }
+
+                    ~ClockFixture()
+                    {
+                        time::setCustomClocks(nullptr, nullptr);
+                    }
+
+                protected:
+                    shared_ptr<time::UnitTestSteadyClock> clock;
+                };
+
+                BOOST_FIXTURE_TEST_CASE(LruOrder, ClockFixture)
+                {
+                    Name a("/A"), b("/B"), c("/C");
+                    StateTable table;
+                    table.setLimit(2);
+
+                    PrefixId idA = table.intern(a);
+                    PrefixId idB = table.intern(b);
+                    BOOST_CHECK_NE(idA, idB);
+                    BOOST_CHECK_EQUAL(table.intern(a), idA);
+
+                    // /B is now the least recently used prefix and makes room for /C
+                    table[idB].get(301);
+                    PrefixId idC = table.intern(c);
+                    BOOST_CHECK_EQUAL(table.size(), 2);
+                    BOOST_CHECK_EQUAL(idC, idB);
+                    BOOST_CHECK_EQUAL(table[idC].getPrefix(), c);
+                    BOOST_CHECK(table[idC].getFaces().empty());
+                    BOOST_CHECK_EQUAL(table.intern(a), idA);
+
+                    // /C is the least recently used prefix after /A was looked up again
+                    PrefixId idB2 = table.intern(b);
+                    BOOST_CHECK_EQUAL(idB2, idC);
+                    BOOST_CHECK_EQUAL(table.intern(a), idA);
+                    BOOST_CHECK_EQUAL(std::distance(table.begin(), table.end()), 2);
+                }
+
+                BOOST_FIXTURE_TEST_CASE(SetLimit, ClockFixture)
+                {
+                    Name a("/A"), b("/B"), c("/C"), d("/D");
+                    StateTable table;
+                    PrefixId idA = table.intern(a);
+                    PrefixId idB = table.intern(b);
+                    PrefixId idC = table.intern(c);
+                    table.intern(a);
+                    BOOST_CHECK_EQUAL(table.size(), 3);
+
+                    table.setLimit(1);
+                    BOOST_CHECK_EQUAL(table.size(), 1);
+                    BOOST_CHECK_EQUAL(table.getLimit(), 1);
+                    BOOST_CHECK_EQUAL(table[idA].getPrefix(), a);
+                    BOOST_CHECK(table[idB].getPrefix().empty());
+                    BOOST_CHECK(table[idC].getPrefix().empty());
+
+                    // /A makes room for /D, whose id is reused, so the table does not grow
+                    PrefixId idD = table.intern(d);
+                    BOOST_CHECK_EQUAL(idD, idA);
+                    BOOST_CHECK_EQUAL(table[idD].getPrefix(), d);
+                    BOOST_CHECK_EQUAL(table.size(), 1);
+                    BOOST_CHECK_EQUAL(std::distance(table.begin(), table.end()), 3);
+
+                    table.setLimit(StateTable::UNLIMITED);
+                    table.intern(a);
+                    table.intern(b);
+                    table.intern(c);
+                    BOOST_CHECK_EQUAL(table.size(), 4);
+                    BOOST_CHECK_EQUAL(std::distance(table.begin(), table.end()), 4);
+                }
+
+                BOOST_FIXTURE_TEST_CASE(EvictIdle, ClockFixture)
+                {
+                    Name a("/A"), b("/B"), c("/C");
+                    StateTable table;
+                    PrefixId idA = table.intern(a);
+                    clock->advance(10_s);
+                    PrefixId idB = table.intern(b);
+                    table[idB].get(301);
+                    clock->advance(10_s);
+                    table.intern(a);
+
+                    // /A was looked up at 20s and /B at 10s
+                    table.evictIdle(time::steady_clock::now() - 15_s);
+                    BOOST_CHECK_EQUAL(table.size(), 2);
+                    table.evictIdle(time::steady_clock::now() - 5_s);
+                    BOOST_CHECK_EQUAL(table.size(), 1);
+                    BOOST_CHECK_EQUAL(table[idA].getPrefix(), a);
+                    BOOST_CHECK(table[idB].getFaces().empty());
+
+                    // the id of /B is reused with no face records, and the LRU list still holds /A
+                    PrefixId idC = table.intern(c);
+                    BOOST_CHECK_EQUAL(idC, idB);
+                    BOOST_CHECK(table[idC].getFaces().empty());
+                    clock->advance(10_s);
+                    table.evictIdle(time::steady_clock::now());
+                    BOOST_CHECK_EQUAL(table.size(), 0);
+                    BOOST_CHECK_EQUAL(table.intern(b), idC);
+                    BOOST_CHECK_EQUAL(table.size(), 1);
+                }
+
+                BOOST_AUTO_TEST_SUITE_END()
+
+                BOOST_AUTO_TEST_SUITE(OMCCRFAliasTable)
+
+                static std::vector<double>
+                drawFrequencies(const FaceStates &faces, int nDraws)
+                {
+                    AliasTable table;
+                    table.build(faces);
+
+                    boost::random::mt19937 rng;
+                    std::vector<int> counts(faces.size(), 0);
+                    for (int i = 0; i < nDraws; ++i)
+                    {
+                        ++counts.at(table.sample(rng));
+                    }
+
+                    std::vector<double> frequencies;
+                    for (int count : counts)
+                    {
+                        frequencies.push_back(static_cast<double>(count) / nDraws);
+                    }
+                    return frequencies;
+                }
+
+                BOOST_AUTO_TEST_CASE(ProportionalToWeight)
+                {
+                    FaceStates faces{{301, 0, 0.0, 1.0}, {302, 0, 0.0, 2.0}, {303, 0, 0.0, 3.0}, {304, 0, 0.0, 4.0},
+                                     {305, 0, 0.0, 0.5}};
+                    auto frequencies = drawFrequencies(faces, 200000);
+                    for (size_t i = 0; i < faces.size(); ++i)
+                    {
+                        BOOST_CHECK_CLOSE_FRACTION(frequencies[i], faces[i].weight / 10.5, 0.03);
+                    }
+                }
+
+                BOOST_AUTO_TEST_CASE(ZeroWeight)
+                {
+                    FaceStates faces{{301, 0, 0.0, 1.0}, {302, 0, 0.0, 0.0}, {303, 0, 0.0, 3.0}};
+                    auto frequencies = drawFrequencies(faces, 20000);
+                    BOOST_CHECK_EQUAL(frequencies[1], 0.0);
+                    BOOST_CHECK_CLOSE_FRACTION(frequencies[0], 0.25, 0.05);
+
+                    // with no weight at all every face is equally likely
+                    for (auto &face : faces)
+                    {
+                        face.weight = 0.0;
+                    }
+                    for (double frequency : drawFrequencies(faces, 30000))
+                    {
+                        BOOST_CHECK_CLOSE_FRACTION(frequency, 1.0 / 3, 0.05);
+                    }
+                }
+
+                BOOST_AUTO_TEST_CASE(SingleFace)
+                {
+                    FaceStates faces{{301, 0, 0.0, 0.25}};
+                    BOOST_CHECK_EQUAL(drawFrequencies(faces, 100)[0], 1.0);
+                }
+
+                BOOST_AUTO_TEST_SUITE_END()
+            }
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include "OMCCRFStrategy.hpp"
+#include "fw/forwarder.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/utils/ndn-time.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+namespace nfd
+{
+    namespace fw
+    {
+        namespace tests
+        {
+            class OMCCRFStrategyTester : public OMCCRFStrategy
+            {
+            public:
+                using OMCCRFStrategy::OMCCRFStrategy;
+
+                using OMCCRFStrategy::ewmaInterval;
+                using OMCCRFStrategy::ewmaTimer;
+                using OMCCRFStrategy::fibWeightUpdate;
+                using OMCCRFStrategy::idleTimeout;
+                using OMCCRFStrategy::lookupState;
+                using OMCCRFStrategy::prefixLength;
+                using OMCCRFStrategy::states;
+                using OMCCRFStrategy::useFibPrefix;
+            };
+
+            class OMCCRFStrategyFixture
+            {
+            public:
+                OMCCRFStrategyFixture()
+                {
+                    // the NFD scheduler reads the ndn-cxx clock, which must follow simulation time
+                    ::ndn::time::setCustomClocks(make_shared<ns3::ndn::time::CustomSteadyClock>(),
+                                                 make_shared<ns3::ndn::time::CustomSystemClock>());
+                }
+
+                ~OMCCRFStrategyFixture()
+                {
+                    ns3::Simulator::Destroy();
+                    ::ndn::time::setCustomClocks(nullptr, nullptr);
+                }
+
+                static Name
+                makeInstanceName(std::initializer_list<std::string> parameters)
+                {
+                    Name name = OMCCRFStrategy::getStrategyName();
+                    for (const auto &parameter : parameters)
+                    {
+                        name.append(parameter);
+                    }
+                    return name;
+                }
+
+                /** \brief run the simulation until \p ms milliseconds from now
+                 */
+                static void
+                advance(int64_t ms)
+                {
+                    ns3::Simulator::Stop(ns3::MilliSeconds(ms));
+                    ns3::Simulator::Run();
+                }
+
+            protected:
+                FaceTable faceTable;
+                Forwarder forwarder{faceTable};
+            };
+
+            BOOST_FIXTURE_TEST_SUITE(TestOMCCRFStrategy, OMCCRFStrategyFixture)
+
+            BOOST_AUTO_TEST_CASE(DefaultParameters)
+            {
+                OMCCRFStrategyTester strategy(forwarder);
+                BOOST_CHECK_EQUAL(strategy.getInstanceName(), OMCCRFStrategy::getStrategyName());
+                BOOST_CHECK_EQUAL(strategy.prefixLength, 1);
+                BOOST_CHECK(!strategy.useFibPrefix);
+                BOOST_CHECK_EQUAL(strategy.ewmaInterval, 0_ms);
+                BOOST_CHECK_EQUAL(strategy.states.getLimit(), omccrf::StateTable::UNLIMITED);
+                BOOST_CHECK_EQUAL(strategy.idleTimeout, 0_ms);
+            }
+
+            BOOST_AUTO_TEST_CASE(Parameters)
+            {
+                Name name = makeInstanceName({"prefix-length~3", "ewma-interval~50", "max-prefixes~100",
+                                              "idle-timeout~2000"});
+                OMCCRFStrategyTester strategy(forwarder, name);
+                BOOST_CHECK_EQUAL(strategy.getInstanceName(), name);
+                BOOST_CHECK_EQUAL(strategy.prefixLength, 3);
+                BOOST_CHECK(!strategy.useFibPrefix);
+                BOOST_CHECK_EQUAL(strategy.ewmaInterval, 50_ms);
+                BOOST_CHECK_EQUAL(strategy.states.getLimit(), 100);
+                BOOST_CHECK_EQUAL(strategy.idleTimeout, 2000_ms);
+
+                OMCCRFStrategyTester fibStrategy(forwarder, makeInstanceName({"prefix-length~fib"}));
+                BOOST_CHECK(fibStrategy.useFibPrefix);
+
+                // the last occurrence of a parameter wins
+                OMCCRFStrategyTester lastStrategy(forwarder, makeInstanceName({"prefix-length~fib", "prefix-length~2"}));
+                BOOST_CHECK(!lastStrategy.useFibPrefix);
+                BOOST_CHECK_EQUAL(lastStrategy.prefixLength, 2);
+            }
+
+            BOOST_AUTO_TEST_CASE(BadParameters)
+            {
+                for (const char *parameter : {"prefix-length", "prefix-length~", "prefix-length~-1",
+                                              "prefix-length~two", "ewma-interval~1.5", "max-prefixes~10k",
+                                              "idle-timeout~-5", "alpha~0.5"})
+                {
+                    BOOST_TEST_CONTEXT(parameter)
+                    {
+                        BOOST_CHECK_THROW(OMCCRFStrategy(forwarder, makeInstanceName({parameter})),
+                                          std::invalid_argument);
+                    }
+                }
+
+                Name badVersion = Name(OMCCRFStrategy::getStrategyName()).getPrefix(-1).appendVersion(2);
+                BOOST_CHECK_THROW(OMCCRFStrategy(forwarder, badVersion), std::invalid_argument);
+            }
+
+            BOOST_AUTO_TEST_CASE(PerPacketEwma)
+            {
+                OMCCRFStrategyTester strategy(forwarder);
+                omccrf::PrefixState &state = strategy.lookupState(PrefixView(Name("/A")));
+                BOOST_CHECK(!strategy.ewmaTimer);
+
+                omccrf::FaceState &face = state.get(301);
+                face.PI = 20;
+                strategy.fibWeightUpdate(state, face);
+                BOOST_CHECK_CLOSE(face.avgPI, 2.0, 1e-9);
+                BOOST_CHECK_CLOSE(face.weight, 0.5, 1e-9);
+            }
+
+            BOOST_AUTO_TEST_CASE(BatchEwma)
+            {
+                OMCCRFStrategyTester strategy(forwarder, makeInstanceName({"ewma-interval~100"}));
+
+                // the timer only runs once a prefix is tracked
+                BOOST_CHECK(!strategy.ewmaTimer);
+                advance(250);
+                BOOST_CHECK(!strategy.ewmaTimer);
+
+                omccrf::PrefixState &state = strategy.lookupState(PrefixView(Name("/A")));
+                BOOST_CHECK(strategy.ewmaTimer);
+
+                // packets only move PI, the timer smooths every face at once
+                state.get(301).PI = 20;
+                state.get(302).PI = 5;
+                strategy.fibWeightUpdate(state, state.getFaces()[0]);
+                const auto &faces = state.getFaces();
+                BOOST_CHECK_EQUAL(faces[0].avgPI, 0.0);
+                BOOST_CHECK_EQUAL(faces[0].weight, 1.0);
+
+                advance(150);
+                BOOST_CHECK_CLOSE(faces[0].avgPI, 2.0, 1e-9);
+                BOOST_CHECK_CLOSE(faces[0].weight, 0.5, 1e-9);
+                BOOST_CHECK_CLOSE(faces[1].avgPI, 0.5, 1e-9);
+                BOOST_CHECK_CLOSE(faces[1].weight, 1.0, 1e-9);
+
+                advance(100);
+                BOOST_CHECK_CLOSE(faces[0].avgPI, 3.8, 1e-9);
+                BOOST_CHECK_CLOSE(faces[0].weight, 1 / 3.8, 1e-9);
+                BOOST_CHECK_CLOSE(faces[1].avgPI, 0.95, 1e-9);
+
+                // with no prefix left the timer stops, and the next lookup restarts it
+                strategy.states.evictIdle(time::steady_clock::TimePoint::max());
+                BOOST_CHECK_EQUAL(strategy.states.size(), 0);
+                advance(100);
+                BOOST_CHECK(!strategy.ewmaTimer);
+
+                strategy.lookupState(PrefixView(Name("/B")));
+                BOOST_CHECK(strategy.ewmaTimer);
+            }
+
+            BOOST_AUTO_TEST_SUITE_END()
+        }
+    }
+}